@@ -0,0 +1,86 @@
+// Autosave.cpp - Background, debounced persistence for the expense list
+#include "Autosave.h"
+
+AutosaveService::AutosaveService(std::vector<Expense> &expenses, Journal &journal,
+                                 std::chrono::milliseconds debounce, std::size_t maxPending)
+    : checkpoint_([&expenses, &journal] { journal.checkpoint(expenses); }), journal_(journal),
+      debounce_(debounce), maxPending_(maxPending), running_(false), stopping_(false), dirty_(false), pending_(0) {}
+
+AutosaveService::AutosaveService(ExpenseTable &expenses, Journal &journal,
+                                 std::chrono::milliseconds debounce, std::size_t maxPending)
+    : checkpoint_([&expenses, &journal] { journal.checkpoint(expenses); }),
+      compact_([&expenses] { if (expenses.needsCompaction()) expenses.compact(); }), journal_(journal),
+      debounce_(debounce), maxPending_(maxPending), running_(false), stopping_(false), dirty_(false), pending_(0) {}
+
+AutosaveService::~AutosaveService() {
+    stop();
+}
+
+void AutosaveService::start() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (running_) return;
+    stopping_ = false;
+    running_ = true;
+    worker_ = std::thread(&AutosaveService::run, this);
+}
+
+void AutosaveService::stop() {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (running_) {
+            stopping_ = true;
+            wake_.notify_all();
+        }
+    }
+    if (worker_.joinable()) worker_.join();
+    std::lock_guard<std::mutex> guard(mutex_);
+    running_ = false;
+    flushLocked();
+}
+
+std::unique_lock<std::mutex> AutosaveService::lock() {
+    return std::unique_lock<std::mutex>(mutex_);
+}
+
+void AutosaveService::markDirty() {
+    dirty_ = true;
+    ++pending_;
+    lastMutation_ = std::chrono::steady_clock::now();
+    wake_.notify_all();
+}
+
+bool AutosaveService::isDirty() const {
+    return dirty_;
+}
+
+/**
+ * @brief Fold the journal into the snapshot if it holds anything, then compact
+ *        the table if deletes have left too many tombstones.
+ */
+void AutosaveService::flushLocked() {
+    if (dirty_ && journal_.isAttached() && journal_.size() > 0) checkpoint_();
+    if (dirty_ && compact_) compact_();
+    dirty_ = false;
+    pending_ = 0;
+}
+
+/**
+ * @brief Background loop: wait for changes, let them settle, then flush.
+ */
+void AutosaveService::run() {
+    std::unique_lock<std::mutex> lk(mutex_);
+    while (!stopping_) {
+        if (!dirty_) {
+            wake_.wait(lk);
+            continue;
+        }
+        if (pending_ < maxPending_ && !journal_.needsCheckpoint()) {
+            auto deadline = lastMutation_ + debounce_;
+            if (std::chrono::steady_clock::now() < deadline) {
+                wake_.wait_until(lk, deadline);
+                continue;
+            }
+        }
+        flushLocked();
+    }
+}
@@ -0,0 +1,123 @@
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include "Expense.h"
+#include "ExpenseTable.h"
+#include "Journal.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Quiet period after the last mutation before the background flush runs.
+ */
+const std::chrono::milliseconds DEFAULT_AUTOSAVE_DEBOUNCE(2000);
+
+/**
+ * @brief Number of unflushed mutations that triggers a flush without waiting for the debounce.
+ */
+const std::size_t DEFAULT_AUTOSAVE_MAX_PENDING = 64;
+
+/**
+ * @brief Background persistence for the expense list.
+ *
+ * Mutations are still appended to the journal immediately, but folding the
+ * journal into the snapshot file (a full rewrite) moves to a background
+ * thread. The store is marked dirty on each mutation; the thread flushes once
+ * no mutation has happened for the debounce interval, or as soon as the
+ * number of pending mutations (or the journal size) passes its limit, so a
+ * burst of edits results in a single write. stop() performs a final blocking flush.
+ * For an ExpenseTable, the flush also compacts the table once deletes have
+ * left more than DEFAULT_TOMBSTONE_RATIO of its slots as tombstones.
+ *
+ * The store (a vector or an ExpenseTable) and the journal are shared with the background thread:
+ * hold lock() while reading or changing either of them.
+ */
+class AutosaveService {
+public:
+    /**
+     * @brief Create a stopped service for the given store.
+     * @param expenses The expense list to persist.
+     * @param journal The journal of the current data file.
+     * @param debounce Quiet period before a flush.
+     * @param maxPending Pending mutation count that forces a flush.
+     */
+    AutosaveService(std::vector<Expense> &expenses, Journal &journal,
+                    std::chrono::milliseconds debounce = DEFAULT_AUTOSAVE_DEBOUNCE,
+                    std::size_t maxPending = DEFAULT_AUTOSAVE_MAX_PENDING);
+
+    /**
+     * @brief Create a stopped service for the given expense table.
+     * @param expenses The expense table to persist.
+     * @param journal The journal of the current data file.
+     * @param debounce Quiet period before a flush.
+     * @param maxPending Pending mutation count that forces a flush.
+     */
+    AutosaveService(ExpenseTable &expenses, Journal &journal,
+                    std::chrono::milliseconds debounce = DEFAULT_AUTOSAVE_DEBOUNCE,
+                    std::size_t maxPending = DEFAULT_AUTOSAVE_MAX_PENDING);
+
+    /**
+     * @brief Stops the background thread, flushing pending changes.
+     */
+    ~AutosaveService();
+
+    AutosaveService(const AutosaveService &) = delete;
+    AutosaveService &operator=(const AutosaveService &) = delete;
+
+    /**
+     * @brief Start the background flush thread.
+     */
+    void start();
+
+    /**
+     * @brief Stop the background thread and flush pending changes before returning.
+     */
+    void stop();
+
+    /**
+     * @brief Lock the expense list and journal against the background thread.
+     * @return The held lock.
+     */
+    std::unique_lock<std::mutex> lock();
+
+    /**
+     * @brief Record that the store changed. Must be called while holding lock().
+     */
+    void markDirty();
+
+    /**
+     * @brief Whether there are changes that have not been flushed yet.
+     *        Must be called while holding lock().
+     */
+    bool isDirty() const;
+
+    /**
+     * @brief Flush pending changes now. Must be called while holding lock().
+     */
+    void flushLocked();
+
+private:
+    void run();
+
+    std::function<void()> checkpoint_; // folds the journal into the snapshot of the store
+    std::function<void()> compact_;    // squeezes tombstones out of a table store; empty for a vector
+    Journal &journal_;
+    std::chrono::milliseconds debounce_;
+    std::size_t maxPending_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::thread worker_;
+    bool running_;
+    bool stopping_;
+    bool dirty_;
+    std::size_t pending_;
+    std::chrono::steady_clock::time_point lastMutation_;
+};
+
+#endif
@@ -0,0 +1,315 @@
+// BinaryStore.cpp - Binary columnar snapshot format (.expb)
+#include "BinaryStore.h"
+#include "BufferedWriter.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <memory>
+
+static_assert(sizeof(BinaryHeader) == 96, "BinaryHeader layout must not change");
+
+namespace {
+
+enum Section { Categories, Ids, Dates, Amounts, CategoryCodes, Offsets, Heap, SectionCount };
+
+/**
+ * @brief Incremental 64-bit checksum: FNV-1a applied to 64-bit words, so it runs at memory speed.
+ */
+class Checksum64 {
+public:
+    void update(const void *data, std::size_t size) {
+        const unsigned char *p = static_cast<const unsigned char *>(data);
+        while (size > 0 && pendingSize_ > 0) {
+            pending_[pendingSize_++] = *p++;
+            --size;
+            if (pendingSize_ == 8) mixPending();
+        }
+        while (size >= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, p, 8);
+            mix(word);
+            p += 8;
+            size -= 8;
+        }
+        while (size-- > 0) pending_[pendingSize_++] = *p++;
+    }
+
+    std::uint64_t value() const {
+        Checksum64 copy = *this;
+        if (copy.pendingSize_ > 0) {
+            std::memset(copy.pending_ + copy.pendingSize_, 0, 8 - copy.pendingSize_);
+            copy.mixPending();
+        }
+        return copy.hash_;
+    }
+
+private:
+    void mix(std::uint64_t word) {
+        hash_ ^= word;
+        hash_ *= 1099511628211ULL;
+    }
+
+    void mixPending() {
+        std::uint64_t word;
+        std::memcpy(&word, pending_, 8);
+        mix(word);
+        pendingSize_ = 0;
+    }
+
+    std::uint64_t hash_ = 14695981039346656037ULL;
+    unsigned char pending_[8] = {};
+    std::size_t pendingSize_ = 0;
+};
+
+std::uint64_t padded(std::uint64_t size) {
+    return (size + 7) & ~std::uint64_t(7);
+}
+
+/**
+ * @brief Compute the unpadded size of each section from the header.
+ */
+void sectionSizes(const BinaryHeader &h, std::uint64_t sizes[SectionCount]) {
+    sizes[Categories] = h.categoryBytes;
+    sizes[Ids] = h.rowCount * sizeof(std::int64_t);
+    sizes[Dates] = h.rowCount * sizeof(std::int32_t);
+    sizes[Amounts] = h.rowCount * sizeof(std::int64_t);
+    sizes[CategoryCodes] = h.rowCount * sizeof(std::uint16_t);
+    sizes[Offsets] = (h.rowCount + 1) * sizeof(std::uint64_t);
+    sizes[Heap] = h.heapBytes;
+}
+
+/**
+ * @brief Writes one section value by value, tracking its checksum and padding it to 8 bytes.
+ */
+class SectionWriter {
+public:
+    SectionWriter(BufferedWriter &out, std::uint64_t &checksum)
+        : out_(out), checksum_(checksum), size_(0) {}
+
+    ~SectionWriter() {
+        static const char zeros[8] = {};
+        std::size_t pad = padded(size_) - size_;
+        write(zeros, pad);
+        checksum_ = sum_.value();
+    }
+
+    void write(const void *data, std::size_t size) {
+        out_.write(std::string_view(static_cast<const char *>(data), size));
+        sum_.update(data, size);
+        size_ += size;
+    }
+
+    template <typename T>
+    void value(T v) { write(&v, sizeof(v)); }
+
+private:
+    BufferedWriter &out_;
+    std::uint64_t &checksum_;
+    Checksum64 sum_;
+    std::uint64_t size_;
+};
+
+} // namespace
+
+/**
+ * @brief Save all expenses to a binary columnar snapshot.
+ *
+ * @param expenses Const reference to the vector of all expenses.
+ * @param filename The name of the file to save the expenses to.
+ * Writes the header, category names, one section per column and the description heap.
+ */
+void saveExpensesBinary(const std::vector<Expense> &expenses, const std::string &filename) {
+    BinaryHeader header = {};
+    std::memcpy(header.magic, "EXPB", 4);
+    header.version = BINARY_FORMAT_VERSION;
+    header.rowCount = expenses.size();
+
+    std::vector<std::int32_t> days(expenses.size());
+    std::vector<std::uint16_t> codes(expenses.size());
+    // Codes are assigned in order of first use; codeOf maps a category ID to its code
+    std::vector<Category> categories;
+    std::vector<int> codeOf(Category::count(), -1);
+    for (std::size_t i = 0; i < expenses.size(); ++i) {
+        const Expense &e = expenses[i];
+        if (!e.date.isValid()) {
+            std::cout << "❌ Invalid date for expense " << e.id
+                      << "; not saved to " << filename << "\n";
+            return;
+        }
+        days[i] = e.date.days();
+        int &code = codeOf[e.category.id()];
+        if (code < 0) {
+            code = static_cast<int>(categories.size());
+            categories.push_back(e.category);
+            header.categoryBytes += sizeof(std::uint32_t) + e.category.name().size();
+        }
+        codes[i] = static_cast<std::uint16_t>(code);
+        header.heapBytes += e.description.size();
+    }
+    header.categoryCount = static_cast<std::uint32_t>(categories.size());
+
+    BufferedWriter out(1 << 20);
+    if (!out.open(filename)) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return;
+    }
+    out.write(std::string_view(reinterpret_cast<const char *>(&header), sizeof(header)));
+    {
+        SectionWriter section(out, header.checksums[Categories]);
+        for (Category category : categories) {
+            const std::string &name = category.name();
+            section.value(static_cast<std::uint32_t>(name.size()));
+            section.write(name.data(), name.size());
+        }
+    }
+    {
+        SectionWriter section(out, header.checksums[Ids]);
+        for (const auto &e : expenses) section.value(static_cast<std::int64_t>(e.id));
+    }
+    {
+        SectionWriter section(out, header.checksums[Dates]);
+        section.write(days.data(), days.size() * sizeof(std::int32_t));
+    }
+    {
+        SectionWriter section(out, header.checksums[Amounts]);
+        for (const auto &e : expenses) section.value(e.amount.cents());
+    }
+    {
+        SectionWriter section(out, header.checksums[CategoryCodes]);
+        section.write(codes.data(), codes.size() * sizeof(std::uint16_t));
+    }
+    {
+        SectionWriter section(out, header.checksums[Offsets]);
+        std::uint64_t offset = 0;
+        section.value(offset);
+        for (const auto &e : expenses) {
+            offset += e.description.size();
+            section.value(offset);
+        }
+    }
+    {
+        SectionWriter section(out, header.checksums[Heap]);
+        for (const auto &e : expenses) section.write(e.description.data(), e.description.size());
+    }
+    out.writeAt(0, std::string_view(reinterpret_cast<const char *>(&header), sizeof(header)));
+    if (!out.close()) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return;
+    }
+    std::cout << "✅ Expenses saved to " << filename << "\n";
+}
+
+/**
+ * @brief Validate the mapped file and locate its sections.
+ *
+ * @param file The mapped .expb file.
+ * @param header Receives the header.
+ * @param sections Receives a pointer to the start of each section.
+ * @return An error message, or an empty string if the file is valid.
+ */
+static std::string validateBinary(const MappedFile &file, BinaryHeader &header,
+                                  const char *sections[SectionCount]) {
+    if (file.size() < sizeof(BinaryHeader)) return "file too small";
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, "EXPB", 4) != 0) return "not an .expb file";
+    if (header.version != BINARY_FORMAT_VERSION && header.version != 1) return "unsupported version " + std::to_string(header.version);
+    // Reject counts that could overflow the size computation below
+    if (header.rowCount > file.size() || header.categoryBytes > file.size() || header.heapBytes > file.size())
+        return "truncated file";
+
+    std::uint64_t sizes[SectionCount];
+    sectionSizes(header, sizes);
+    std::uint64_t offset = sizeof(BinaryHeader);
+    for (int s = 0; s < SectionCount; ++s) {
+        if (offset + padded(sizes[s]) > file.size()) return "truncated file";
+        sections[s] = file.data() + offset;
+        Checksum64 sum;
+        sum.update(sections[s], padded(sizes[s]));
+        if (sum.value() != header.checksums[s]) return "checksum mismatch";
+        offset += padded(sizes[s]);
+    }
+    if (offset != file.size()) return "unexpected trailing data";
+    return "";
+}
+
+/**
+ * @brief Load expenses from a binary columnar snapshot into the expenses vector.
+ * @param expenses Reference to the vector of all expenses.
+ * @param filename The name of the file to load the expenses from.
+ * Maps the file, verifies the checksums and copies each column out in bulk.
+ * Descriptions are not copied: they point straight into the mapping, which
+ * stays open until the last loaded expense is gone. Saves replace the file by
+ * renaming a new one over it, so they never disturb a live mapping.
+ */
+void loadExpensesBinary(std::vector<Expense> &expenses, const std::string &filename) {
+    expenses.clear();
+    auto mapping = std::make_shared<MappedFile>();
+    MappedFile &file = *mapping;
+    if (!file.open(filename)) {
+        std::cout << "❌ No binary file found: " << filename << "\n";
+        return;
+    }
+    BinaryHeader header = {};
+    const char *sections[SectionCount] = {};
+    std::string error = validateBinary(file, header, sections);
+    if (!error.empty()) {
+        std::cout << "❌ Error reading binary file " << filename << ": " << error << "\n";
+        return;
+    }
+
+    std::vector<Category> categories;
+    const char *p = sections[Categories];
+    const char *end = p + header.categoryBytes;
+    for (std::uint32_t c = 0; c < header.categoryCount; ++c) {
+        std::uint32_t len;
+        if (end - p < static_cast<std::ptrdiff_t>(sizeof(len))) { error = "corrupt category table"; break; }
+        std::memcpy(&len, p, sizeof(len));
+        p += sizeof(len);
+        if (static_cast<std::uint64_t>(end - p) < len) { error = "corrupt category table"; break; }
+        categories.push_back(Category::intern(std::string_view(p, len)));
+        p += len;
+    }
+    if (!error.empty()) {
+        std::cout << "❌ Error reading binary file " << filename << ": " << error << "\n";
+        return;
+    }
+
+    std::size_t n = header.rowCount;
+    std::vector<std::int64_t> ids(n);
+    std::vector<std::int32_t> days(n);
+    std::vector<std::int64_t> amounts(n);
+    std::vector<std::uint16_t> codes(n);
+    std::vector<std::uint64_t> offsets(n + 1);
+    std::memcpy(ids.data(), sections[Ids], n * sizeof(std::int64_t));
+    std::memcpy(days.data(), sections[Dates], n * sizeof(std::int32_t));
+    std::memcpy(amounts.data(), sections[Amounts], n * sizeof(std::int64_t));
+    std::memcpy(codes.data(), sections[CategoryCodes], n * sizeof(std::uint16_t));
+    std::memcpy(offsets.data(), sections[Offsets], (n + 1) * sizeof(std::uint64_t));
+    if (offsets[0] != 0 || offsets[n] != header.heapBytes) {
+        std::cout << "❌ Error reading binary file " << filename << ": corrupt description offsets\n";
+        return;
+    }
+
+    const char *heap = sections[Heap];
+    expenses.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (codes[i] >= categories.size() || offsets[i + 1] < offsets[i]) {
+            expenses.clear();
+            std::cout << "❌ Error reading binary file " << filename << ": corrupt row " << i << "\n";
+            return;
+        }
+        Expense e;
+        e.id = ids[i];
+        e.date = Date::fromDays(days[i]);
+        if (header.version == 1) {
+            double units;
+            std::memcpy(&units, &amounts[i], sizeof(units));
+            e.amount = units;
+        } else {
+            e.amount = Money::fromCents(amounts[i]);
+        }
+        e.category = categories[codes[i]];
+        e.description = Description(mapping, std::string_view(heap + offsets[i], offsets[i + 1] - offsets[i]));
+        expenses.push_back(std::move(e));
+    }
+    std::cout << "✅ Expenses loaded from " << filename << "\n";
+}
@@ -0,0 +1,60 @@
+#ifndef BINARY_STORE_H
+#define BINARY_STORE_H
+
+#include "Expense.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Current version of the binary columnar snapshot format (.expb).
+ */
+const std::uint32_t BINARY_FORMAT_VERSION = 2;
+
+/**
+ * @brief Fixed-size header at the start of every .expb file.
+ *
+ * The header is followed by seven sections, each padded to 8 bytes:
+ *   1. category names: for each category a uint32 length and the name bytes
+ *   2. ids: int64[rowCount]
+ *   3. dates: int32[rowCount] (days since 1970-01-01)
+ *   4. amounts: int64[rowCount] (cents; version 1 files stored double units)
+ *   5. categories: uint16[rowCount] (index into the category names)
+ *   6. description offsets: uint64[rowCount + 1] (into the description heap)
+ *   7. description heap: the concatenated description bytes
+ *
+ * Values are stored in the host byte order (little-endian on supported
+ * platforms). Each section has its own checksum so corruption is detected on load.
+ * Version 1 files are still read.
+ */
+struct BinaryHeader {
+    char magic[4];                 ///< "EXPB"
+    std::uint32_t version;         ///< BINARY_FORMAT_VERSION
+    std::uint64_t rowCount;        ///< Number of expenses
+    std::uint32_t categoryCount;   ///< Number of distinct category names
+    std::uint32_t reserved;        ///< Always 0
+    std::uint64_t categoryBytes;   ///< Unpadded size of the category name section
+    std::uint64_t heapBytes;       ///< Size of the description heap
+    std::uint64_t checksums[7];    ///< One checksum per section, in section order
+};
+
+/**
+ * @brief Saves the list of expenses to a binary columnar snapshot (.expb).
+ *
+ * @param expenses The vector of Expense objects to be saved.
+ * @param filename The name of the file to save the expenses to.
+ */
+void saveExpensesBinary(const std::vector<Expense> &expenses, const std::string &filename);
+
+/**
+ * @brief Loads expenses from a binary columnar snapshot (.expb) into the provided vector.
+ *
+ * The file is memory-mapped, validated against its header and checksums,
+ * and each column is copied out in bulk. On any error the vector is left empty.
+ *
+ * @param expenses The vector to populate with loaded Expense objects.
+ * @param filename The name of the file to load the expenses from.
+ */
+void loadExpensesBinary(std::vector<Expense> &expenses, const std::string &filename);
+
+#endif
@@ -0,0 +1,354 @@
+// BlockStore.cpp - Block-compressed archive format with per-block zone maps (.expz)
+#include "BlockStore.h"
+#include "BufferedWriter.h"
+#include "MappedFile.h"
+#include "Utils.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <zlib.h>
+
+static_assert(sizeof(BlockFileHeader) == 32, "BlockFileHeader layout must not change");
+static_assert(sizeof(BlockHeader) == 48, "BlockHeader layout must not change");
+
+namespace {
+
+/**
+ * @brief Zone map bit for a category code; codes of 63 and above share the last bit.
+ */
+std::uint64_t categoryBit(std::uint16_t code) {
+    return std::uint64_t(1) << std::min<std::uint16_t>(code, 63);
+}
+
+/**
+ * @brief Raw payload size of a block with the given row count and description bytes.
+ */
+std::uint64_t rawBlockSize(std::uint64_t rows, std::uint64_t heapBytes) {
+    return rows * (sizeof(std::int64_t) + sizeof(std::int64_t) + sizeof(std::int32_t) + sizeof(std::uint16_t))
+           + (rows + 1) * sizeof(std::uint32_t) + heapBytes;
+}
+
+/**
+ * @brief CRC-32 over a block header (with its checksum field zeroed) and its compressed payload.
+ */
+std::uint32_t blockChecksum(BlockHeader header, const char *payload) {
+    header.checksum = 0;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(&header), sizeof(header));
+    crc = crc32(crc, reinterpret_cast<const Bytef *>(payload), header.compressedBytes);
+    return static_cast<std::uint32_t>(crc);
+}
+
+template <typename T>
+void appendValue(std::string &buffer, T v) {
+    buffer.append(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+
+/**
+ * @brief A validated archive: its header, category names and the location of every block.
+ */
+struct Archive {
+    BlockFileHeader header = {};
+    std::vector<Category> categories;
+    std::vector<std::pair<BlockHeader, const char *>> blocks;
+};
+
+/**
+ * @brief Validate the mapped file header and category table and walk the block headers.
+ *        Block payloads are not touched; they are verified when decoded.
+ * @return An error message, or an empty string if the file is valid.
+ */
+std::string openArchive(const MappedFile &file, Archive &archive) {
+    if (file.size() < sizeof(BlockFileHeader)) return "file too small";
+    BlockFileHeader &header = archive.header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, "EXPZ", 4) != 0) return "not an .expz file";
+    if (header.version != BLOCK_FORMAT_VERSION) return "unsupported version " + std::to_string(header.version);
+
+    const char *p = file.data() + sizeof(header);
+    const char *end = file.data() + file.size();
+    if (static_cast<std::uint64_t>(end - p) < header.categoryBytes) return "truncated file";
+    const char *tableEnd = p + header.categoryBytes;
+    uLong crc = crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef *>(p), header.categoryBytes);
+    if (static_cast<std::uint32_t>(crc) != header.categoryChecksum) return "checksum mismatch";
+    for (std::uint32_t c = 0; c < header.categoryCount; ++c) {
+        std::uint32_t len;
+        if (tableEnd - p < static_cast<std::ptrdiff_t>(sizeof(len))) return "corrupt category table";
+        std::memcpy(&len, p, sizeof(len));
+        p += sizeof(len);
+        if (static_cast<std::uint64_t>(tableEnd - p) < len) return "corrupt category table";
+        archive.categories.push_back(Category::intern(std::string_view(p, len)));
+        p += len;
+    }
+    if (p != tableEnd) return "corrupt category table";
+
+    std::uint64_t rows = 0;
+    for (std::uint32_t b = 0; b < header.blockCount; ++b) {
+        BlockHeader block;
+        if (static_cast<std::size_t>(end - p) < sizeof(block)) return "truncated file";
+        std::memcpy(&block, p, sizeof(block));
+        p += sizeof(block);
+        if (static_cast<std::uint64_t>(end - p) < block.compressedBytes) return "truncated file";
+        archive.blocks.emplace_back(block, p);
+        p += block.compressedBytes;
+        rows += block.rowCount;
+    }
+    if (p != end) return "unexpected trailing data";
+    if (rows != header.rowCount) return "row count mismatch";
+    return "";
+}
+
+/**
+ * @brief Verify and decompress one block, appending the rows accepted by keep(day, amount, code).
+ *        Descriptions of the kept rows are copied into arena.
+ * @return An error message, or an empty string on success.
+ */
+template <typename Keep>
+std::string decodeBlock(const BlockHeader &block, const char *payload,
+                        const std::vector<Category> &categories, Keep keep,
+                        const std::shared_ptr<StringArena> &arena, std::vector<Expense> &out) {
+    if (blockChecksum(block, payload) != block.checksum) return "checksum mismatch";
+    std::size_t n = block.rowCount;
+    if (block.rawBytes < rawBlockSize(n, 0)) return "corrupt block";
+    std::vector<char> raw(block.rawBytes);
+    uLongf rawSize = block.rawBytes;
+    if (uncompress(reinterpret_cast<Bytef *>(raw.data()), &rawSize,
+                   reinterpret_cast<const Bytef *>(payload), block.compressedBytes) != Z_OK ||
+        rawSize != block.rawBytes)
+        return "corrupt block";
+
+    std::vector<std::int64_t> ids(n);
+    std::vector<std::int64_t> amounts(n);
+    std::vector<std::int32_t> days(n);
+    std::vector<std::uint32_t> offsets(n + 1);
+    std::vector<std::uint16_t> codes(n);
+    const char *p = raw.data();
+    std::memcpy(ids.data(), p, n * sizeof(std::int64_t));
+    p += n * sizeof(std::int64_t);
+    std::memcpy(amounts.data(), p, n * sizeof(std::int64_t));
+    p += n * sizeof(std::int64_t);
+    std::memcpy(days.data(), p, n * sizeof(std::int32_t));
+    p += n * sizeof(std::int32_t);
+    std::memcpy(offsets.data(), p, (n + 1) * sizeof(std::uint32_t));
+    p += (n + 1) * sizeof(std::uint32_t);
+    std::memcpy(codes.data(), p, n * sizeof(std::uint16_t));
+    p += n * sizeof(std::uint16_t);
+    if (offsets[0] != 0 || rawBlockSize(n, offsets[n]) != block.rawBytes) return "corrupt block";
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (codes[i] >= categories.size() || offsets[i + 1] < offsets[i] || offsets[i + 1] > offsets[n])
+            return "corrupt row";
+        if (!keep(days[i], amounts[i], codes[i])) continue;
+        Expense e;
+        e.id = ids[i];
+        e.date = Date::fromDays(days[i]);
+        e.amount = Money::fromCents(amounts[i]);
+        e.category = categories[codes[i]];
+        e.description = Description::inArena(arena, std::string_view(p + offsets[i], offsets[i + 1] - offsets[i]));
+        out.push_back(std::move(e));
+    }
+    return "";
+}
+
+} // namespace
+
+/**
+ * @brief Save all expenses to a block-compressed archive.
+ *
+ * @param expenses Const reference to the vector of all expenses.
+ * @param filename The name of the file to save the expenses to.
+ * @param blockRows Number of rows per compressed block.
+ * Rows are cut into blocks; each block's columns are compressed together and
+ * prefixed with a header holding the block's zone map.
+ */
+void saveExpensesBlocks(const std::vector<Expense> &expenses, const std::string &filename, std::size_t blockRows) {
+    if (blockRows == 0) blockRows = DEFAULT_BLOCK_ROWS;
+    std::vector<std::int32_t> days(expenses.size());
+    std::vector<std::uint16_t> codes(expenses.size());
+    std::string table;
+    // Codes are assigned in order of first use; codeOf maps a category ID to its code
+    std::vector<int> codeOf(Category::count(), -1);
+    int categoryCount = 0;
+    for (std::size_t i = 0; i < expenses.size(); ++i) {
+        const Expense &e = expenses[i];
+        if (!e.date.isValid()) {
+            std::cout << "❌ Invalid date for expense " << e.id
+                      << "; not saved to " << filename << "\n";
+            return;
+        }
+        days[i] = e.date.days();
+        int &code = codeOf[e.category.id()];
+        if (code < 0) {
+            code = categoryCount++;
+            const std::string &name = e.category.name();
+            appendValue(table, static_cast<std::uint32_t>(name.size()));
+            table += name;
+        }
+        codes[i] = static_cast<std::uint16_t>(code);
+    }
+
+    BlockFileHeader header = {};
+    std::memcpy(header.magic, "EXPZ", 4);
+    header.version = BLOCK_FORMAT_VERSION;
+    header.rowCount = expenses.size();
+    header.blockCount = static_cast<std::uint32_t>((expenses.size() + blockRows - 1) / blockRows);
+    header.categoryCount = static_cast<std::uint32_t>(categoryCount);
+    header.categoryBytes = static_cast<std::uint32_t>(table.size());
+    header.categoryChecksum = static_cast<std::uint32_t>(
+        crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef *>(table.data()), table.size()));
+
+    BufferedWriter out(1 << 20);
+    if (!out.open(filename)) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return;
+    }
+    out.write(std::string_view(reinterpret_cast<const char *>(&header), sizeof(header)));
+    out.write(table);
+
+    std::string raw;
+    std::vector<char> compressed;
+    for (std::size_t begin = 0; begin < expenses.size(); begin += blockRows) {
+        std::size_t end = std::min(expenses.size(), begin + blockRows);
+        BlockHeader block = {};
+        block.rowCount = static_cast<std::uint32_t>(end - begin);
+        block.minDate = block.maxDate = days[begin];
+        block.minAmount = block.maxAmount = expenses[begin].amount.cents();
+
+        raw.clear();
+        for (std::size_t i = begin; i < end; ++i) appendValue(raw, static_cast<std::int64_t>(expenses[i].id));
+        for (std::size_t i = begin; i < end; ++i) {
+            std::int64_t cents = expenses[i].amount.cents();
+            appendValue(raw, cents);
+            block.minAmount = std::min(block.minAmount, cents);
+            block.maxAmount = std::max(block.maxAmount, cents);
+        }
+        for (std::size_t i = begin; i < end; ++i) {
+            appendValue(raw, days[i]);
+            block.minDate = std::min(block.minDate, days[i]);
+            block.maxDate = std::max(block.maxDate, days[i]);
+        }
+        std::uint32_t offset = 0;
+        appendValue(raw, offset);
+        for (std::size_t i = begin; i < end; ++i) {
+            offset += static_cast<std::uint32_t>(expenses[i].description.size());
+            appendValue(raw, offset);
+        }
+        for (std::size_t i = begin; i < end; ++i) {
+            appendValue(raw, codes[i]);
+            block.categoryMask |= categoryBit(codes[i]);
+        }
+        for (std::size_t i = begin; i < end; ++i) raw += expenses[i].description.view();
+
+        uLongf compressedSize = compressBound(raw.size());
+        compressed.resize(compressedSize);
+        if (compress2(reinterpret_cast<Bytef *>(compressed.data()), &compressedSize,
+                      reinterpret_cast<const Bytef *>(raw.data()), raw.size(), Z_DEFAULT_COMPRESSION) != Z_OK) {
+            std::cout << "❌ Could not compress " << filename << "\n";
+            return;
+        }
+        block.rawBytes = static_cast<std::uint32_t>(raw.size());
+        block.compressedBytes = static_cast<std::uint32_t>(compressedSize);
+        block.checksum = blockChecksum(block, compressed.data());
+        out.write(std::string_view(reinterpret_cast<const char *>(&block), sizeof(block)));
+        out.write(std::string_view(compressed.data(), compressedSize));
+    }
+    if (!out.close()) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return;
+    }
+    std::cout << "✅ Expenses saved to " << filename << "\n";
+}
+
+/**
+ * @brief Load expenses from a block-compressed archive into the expenses vector.
+ * @param expenses Reference to the vector of all expenses.
+ * @param filename The name of the file to load the expenses from.
+ * Maps the file and decompresses every block after verifying its checksum.
+ */
+void loadExpensesBlocks(std::vector<Expense> &expenses, const std::string &filename) {
+    expenses.clear();
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cout << "❌ No compressed file found: " << filename << "\n";
+        return;
+    }
+    Archive archive;
+    std::string error = openArchive(file, archive);
+    auto keepAll = [](std::int32_t, std::int64_t, std::uint16_t) { return true; };
+    auto arena = std::make_shared<StringArena>();
+    for (std::size_t b = 0; error.empty() && b < archive.blocks.size(); ++b) {
+        const auto &block = archive.blocks[b];
+        error = decodeBlock(block.first, block.second, archive.categories, keepAll, arena, expenses);
+    }
+    if (!error.empty()) {
+        expenses.clear();
+        std::cout << "❌ Error reading compressed file " << filename << ": " << error << "\n";
+        return;
+    }
+    std::cout << "✅ Expenses loaded from " << filename << "\n";
+}
+
+/**
+ * @brief Collect matching expenses, skipping blocks whose zone map rules out the filter.
+ * @param filename The name of the archive to scan.
+ * @param filter The conditions expenses must meet.
+ * @param matches Receives the matching expenses.
+ * @return How many blocks were scanned and skipped.
+ */
+BlockScanStats scanExpensesBlocks(const std::string &filename, const BlockFilter &filter,
+                                  std::vector<Expense> &matches) {
+    BlockScanStats stats;
+    matches.clear();
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cout << "❌ No compressed file found: " << filename << "\n";
+        return stats;
+    }
+    Archive archive;
+    std::string error = openArchive(file, archive);
+    if (!error.empty()) {
+        std::cout << "❌ Error reading compressed file " << filename << ": " << error << "\n";
+        return stats;
+    }
+    stats.blocks = archive.blocks.size();
+
+    std::int32_t minDay = std::numeric_limits<std::int32_t>::min();
+    std::int32_t maxDay = std::numeric_limits<std::int32_t>::max();
+    if (!filter.startDate.empty() && !dateToDays(filter.startDate, minDay)) return stats;
+    if (!filter.endDate.empty() && !dateToDays(filter.endDate, maxDay)) return stats;
+    int code = -1;
+    if (!filter.category.empty()) {
+        auto it = std::find(archive.categories.begin(), archive.categories.end(), filter.category);
+        if (it == archive.categories.end()) {
+            // No row can match a category the archive does not contain
+            stats.skippedBlocks = stats.blocks;
+            return stats;
+        }
+        code = static_cast<int>(it - archive.categories.begin());
+    }
+    std::uint64_t bit = code >= 0 ? categoryBit(static_cast<std::uint16_t>(code)) : ~std::uint64_t(0);
+    std::int64_t minCents = filter.minAmount.cents();
+    std::int64_t maxCents = filter.maxAmount.cents();
+    auto keep = [&](std::int32_t day, std::int64_t cents, std::uint16_t c) {
+        return day >= minDay && day <= maxDay && cents >= minCents && cents <= maxCents &&
+               (code < 0 || c == code);
+    };
+
+    auto arena = std::make_shared<StringArena>();
+    for (const auto &block : archive.blocks) {
+        const BlockHeader &h = block.first;
+        if (h.maxDate < minDay || h.minDate > maxDay || h.maxAmount < minCents ||
+            h.minAmount > maxCents || (h.categoryMask & bit) == 0) {
+            ++stats.skippedBlocks;
+            continue;
+        }
+        error = decodeBlock(h, block.second, archive.categories, keep, arena, matches);
+        if (!error.empty()) {
+            matches.clear();
+            std::cout << "❌ Error reading compressed file " << filename << ": " << error << "\n";
+            return stats;
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,117 @@
+#ifndef BLOCK_STORE_H
+#define BLOCK_STORE_H
+
+#include "Expense.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Current version of the block-compressed archive format (.expz).
+ */
+const std::uint32_t BLOCK_FORMAT_VERSION = 2;
+
+/**
+ * @brief Default number of rows per compressed block.
+ */
+const std::size_t DEFAULT_BLOCK_ROWS = 4096;
+
+/**
+ * @brief Fixed-size header at the start of every .expz file.
+ *
+ * The header is followed by the category name table (for each category a
+ * uint32 length and the name bytes) and then blockCount blocks. Each block is
+ * a BlockHeader followed by its zlib-compressed payload, which holds the
+ * block's columns back to back:
+ *   ids int64[n], amounts int64[n] (cents), dates int32[n] (days since 1970-01-01),
+ *   description offsets uint32[n + 1], categories uint16[n], description bytes.
+ *
+ * Values are stored in the host byte order (little-endian on supported platforms).
+ */
+struct BlockFileHeader {
+    char magic[4];                   ///< "EXPZ"
+    std::uint32_t version;           ///< BLOCK_FORMAT_VERSION
+    std::uint64_t rowCount;          ///< Number of expenses in all blocks
+    std::uint32_t blockCount;        ///< Number of blocks
+    std::uint32_t categoryCount;     ///< Number of distinct category names
+    std::uint32_t categoryBytes;     ///< Size of the category name table
+    std::uint32_t categoryChecksum;  ///< CRC-32 of the category name table
+};
+
+/**
+ * @brief Header of one compressed block, including its zone map.
+ *
+ * The zone map (date range, amount range, category mask) summarizes every row
+ * in the block, so a scan can skip blocks that cannot match without
+ * decompressing them. Category codes of 63 and above all share bit 63.
+ */
+struct BlockHeader {
+    std::uint32_t rowCount;          ///< Number of rows in the block
+    std::uint32_t rawBytes;          ///< Size of the payload after decompression
+    std::uint32_t compressedBytes;   ///< Size of the compressed payload that follows
+    std::uint32_t checksum;          ///< CRC-32 of this header (with checksum 0) and the compressed payload
+    std::int32_t minDate;            ///< Earliest date in the block (days since 1970-01-01)
+    std::int32_t maxDate;            ///< Latest date in the block
+    std::int64_t minAmount;          ///< Smallest amount in the block, in cents
+    std::int64_t maxAmount;          ///< Largest amount in the block, in cents
+    std::uint64_t categoryMask;      ///< Bit c is set if category code c occurs in the block
+};
+
+/**
+ * @brief Conditions for scanning a block-compressed archive. Empty or default
+ *        fields do not restrict the scan; all set fields must match.
+ */
+struct BlockFilter {
+    std::string startDate;   ///< Earliest date (YYYY-MM-DD, inclusive)
+    std::string endDate;     ///< Latest date (YYYY-MM-DD, inclusive)
+    std::string category;    ///< Exact category name
+    Money minAmount = Money::fromCents(std::numeric_limits<std::int64_t>::min()); ///< Smallest amount (inclusive)
+    Money maxAmount = Money::fromCents(std::numeric_limits<std::int64_t>::max()); ///< Largest amount (inclusive)
+};
+
+/**
+ * @brief Block counts reported by scanExpensesBlocks().
+ */
+struct BlockScanStats {
+    std::size_t blocks = 0;         ///< Blocks in the file
+    std::size_t skippedBlocks = 0;  ///< Blocks excluded by their zone map without decompressing
+};
+
+/**
+ * @brief Saves the list of expenses to a block-compressed archive (.expz).
+ *
+ * @param expenses The vector of Expense objects to be saved.
+ * @param filename The name of the file to save the expenses to.
+ * @param blockRows Number of rows per compressed block.
+ */
+void saveExpensesBlocks(const std::vector<Expense> &expenses, const std::string &filename,
+                        std::size_t blockRows = DEFAULT_BLOCK_ROWS);
+
+/**
+ * @brief Loads all expenses from a block-compressed archive (.expz) into the provided vector.
+ *
+ * Every block is verified against its checksum and decompressed. On any error
+ * the vector is left empty.
+ *
+ * @param expenses The vector to populate with loaded Expense objects.
+ * @param filename The name of the file to load the expenses from.
+ */
+void loadExpensesBlocks(std::vector<Expense> &expenses, const std::string &filename);
+
+/**
+ * @brief Collects the expenses in a block-compressed archive that match a filter.
+ *
+ * Blocks whose zone map rules out the filter are skipped without being
+ * decompressed (or, thanks to the memory map, even read from disk).
+ *
+ * @param filename The name of the archive to scan.
+ * @param filter The conditions expenses must meet.
+ * @param matches Receives the matching expenses in file order.
+ * @return How many blocks were scanned and skipped.
+ */
+BlockScanStats scanExpensesBlocks(const std::string &filename, const BlockFilter &filter,
+                                  std::vector<Expense> &matches);
+
+#endif
@@ -0,0 +1,156 @@
+// BufferedWriter.cpp - Buffered output sink for the file serializers
+#include "BufferedWriter.h"
+#include <cerrno>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <unistd.h>
+
+/**
+ * @brief fsync the directory containing a file so a rename into it survives a crash.
+ */
+static bool syncParentDirectory(const std::string &path) {
+    std::filesystem::path dir = std::filesystem::path(path).parent_path();
+    if (dir.empty()) dir = ".";
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+
+BufferedWriter::BufferedWriter(std::size_t bufferSize)
+    : fd_(-1), ok_(false), inPlace_(false), buffer_(bufferSize > 0 ? bufferSize : 1), used_(0), written_(0) {}
+
+BufferedWriter::~BufferedWriter() {
+    discard();
+}
+
+std::string BufferedWriter::tempPathFor(const std::string &path) {
+    return path + ".tmp";
+}
+
+bool BufferedWriter::openInPlace(const std::string &path, std::size_t offset) {
+    discard();
+    path_ = path;
+    inPlace_ = true;
+    fd_ = ::open(path.c_str(), O_WRONLY);
+    ok_ = fd_ >= 0 && ::lseek(fd_, static_cast<off_t>(offset), SEEK_SET) >= 0;
+    used_ = 0;
+    written_ = offset;
+    return ok_;
+}
+
+bool BufferedWriter::open(const std::string &path) {
+    discard();
+    path_ = path;
+    inPlace_ = false;
+    tempPath_ = tempPathFor(path);
+    fd_ = ::open(tempPath_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    ok_ = fd_ >= 0;
+    used_ = 0;
+    written_ = 0;
+    return ok_;
+}
+
+/**
+ * @brief Write the whole range, retrying on partial writes and interrupts.
+ */
+bool BufferedWriter::writeAll(const char *data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd_, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ok_ = false;
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+        written_ += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+void BufferedWriter::write(std::string_view data) {
+    if (!ok_) return;
+    if (used_ + data.size() > buffer_.size()) {
+        flush();
+        if (data.size() >= buffer_.size()) {
+            writeAll(data.data(), data.size());
+            return;
+        }
+    }
+    std::memcpy(buffer_.data() + used_, data.data(), data.size());
+    used_ += data.size();
+}
+
+void BufferedWriter::put(char c) {
+    if (!ok_) return;
+    if (used_ == buffer_.size()) flush();
+    buffer_[used_++] = c;
+}
+
+bool BufferedWriter::flush() {
+    if (ok_ && used_ > 0) writeAll(buffer_.data(), used_);
+    used_ = 0;
+    return ok_;
+}
+
+bool BufferedWriter::writeAt(std::size_t offset, std::string_view data) {
+    if (!flush()) return false;
+    while (!data.empty()) {
+        ssize_t n = ::pwrite(fd_, data.data(), data.size(), static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ok_ = false;
+            return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(n));
+        offset += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+std::size_t BufferedWriter::position() const {
+    return written_ + used_;
+}
+
+/**
+ * @brief Commit the new file: data is on disk before the rename, and the rename before returning.
+ */
+bool BufferedWriter::close() {
+    if (fd_ < 0) return false;
+    flush();
+    if (inPlace_ && ok_ && ::ftruncate(fd_, static_cast<off_t>(written_)) != 0) ok_ = false;
+    if (ok_ && ::fsync(fd_) != 0) ok_ = false;
+    if (::close(fd_) != 0) ok_ = false;
+    fd_ = -1;
+    if (!ok_) {
+        discard();
+        return false;
+    }
+    ok_ = false;
+    if (inPlace_) return true;
+    if (std::rename(tempPath_.c_str(), path_.c_str()) != 0) {
+        discard();
+        return false;
+    }
+    tempPath_.clear();
+    return syncParentDirectory(path_);
+}
+
+void BufferedWriter::discard() {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    ok_ = false;
+    used_ = 0;
+    if (!tempPath_.empty()) {
+        std::remove(tempPath_.c_str());
+        tempPath_.clear();
+    }
+}
+
+bool BufferedWriter::ok() const {
+    return ok_;
+}
@@ -0,0 +1,126 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Buffered output sink writing straight to a file descriptor.
+ *
+ * Serializers append small pieces (punctuation, numbers, escaped strings)
+ * and the writer issues one write() per filled buffer, avoiding the
+ * per-insertion overhead of std::ostream formatting.
+ * Errors are sticky: once a write fails, ok() stays false.
+ *
+ * Writes are crash-safe: bytes go to "<path>.tmp" and close() fsyncs it and
+ * atomically renames it over the target, so a crash mid-save leaves the
+ * previous file intact. A writer destroyed without close() discards the
+ * temporary file.
+ */
+class BufferedWriter {
+public:
+    /**
+     * @brief Create a writer that is not yet attached to a file.
+     * @param bufferSize Number of bytes collected before each write().
+     */
+    explicit BufferedWriter(std::size_t bufferSize = 1 << 16);
+
+    /**
+     * @brief Discards the temporary file if close() was never called.
+     */
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter &) = delete;
+    BufferedWriter &operator=(const BufferedWriter &) = delete;
+
+    /**
+     * @brief Start writing a new version of the given file.
+     *        The target is untouched until close() succeeds.
+     * @param path Path of the file to write.
+     * @return True if the temporary file was created.
+     */
+    bool open(const std::string &path);
+
+    /**
+     * @brief Modify an existing file in place, writing from the given offset.
+     *        close() truncates the file at the final position and fsyncs it;
+     *        there is no temporary file, so callers must only append.
+     * @param path Path of the existing file.
+     * @param offset Byte offset where writing starts.
+     * @return True if the file was opened.
+     */
+    bool openInPlace(const std::string &path, std::size_t offset);
+
+    /**
+     * @brief Append bytes to the buffer, writing it out when full.
+     * @param data The bytes to append.
+     */
+    void write(std::string_view data);
+
+    /**
+     * @brief Append a single character.
+     * @param c The character to append.
+     */
+    void put(char c);
+
+    /**
+     * @brief Overwrite bytes at an absolute file offset (e.g. to patch a header).
+     *        Buffered bytes are flushed first.
+     * @param offset Byte offset from the start of the file.
+     * @param data The bytes to write.
+     * @return True if no error has occurred so far.
+     */
+    bool writeAt(std::size_t offset, std::string_view data);
+
+    /**
+     * @brief Number of bytes written so far, including buffered bytes.
+     */
+    std::size_t position() const;
+
+    /**
+     * @brief Write out any buffered bytes.
+     * @return True if no error has occurred so far.
+     */
+    bool flush();
+
+    /**
+     * @brief Flush, fsync and atomically rename the temporary file over the target,
+     *        then fsync the directory so the rename itself is durable.
+     *        In-place writers are truncated at the current position and fsynced.
+     * @return True if every write succeeded and the new contents replaced the target.
+     */
+    bool close();
+
+    /**
+     * @brief Close and remove the temporary file, leaving the target untouched.
+     */
+    void discard();
+
+    /**
+     * @brief Temporary path used while writing the given file.
+     * @param path The target file.
+     * @return "<path>.tmp"
+     */
+    static std::string tempPathFor(const std::string &path);
+
+    /**
+     * @brief Whether the file is open and no write has failed.
+     */
+    bool ok() const;
+
+private:
+    bool writeAll(const char *data, std::size_t size);
+
+    int fd_;
+    bool ok_;
+    bool inPlace_;
+    std::string path_;
+    std::string tempPath_;
+    std::vector<char> buffer_;
+    std::size_t used_;
+    std::size_t written_;
+};
+
+#endif
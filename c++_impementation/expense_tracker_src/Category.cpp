@@ -0,0 +1,129 @@
+// Category.cpp - Interned expense categories
+#include "Category.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace {
+
+// ID order matches the menu numbers of getCategoryByNumber()
+const std::string_view BUILTIN_NAMES[Category::BUILTIN_COUNT] = {
+    "", "Housing", "Transportation", "Food & Dining", "Utilities & Communication",
+    "Healthcare & Insurance", "Personal & Debt", "Other"
+};
+
+const std::uint16_t OTHER_ID = 7;
+const std::size_t CHUNK_SIZE = 256;
+
+/**
+ * @brief Name storage and lookup for all categories.
+ *
+ * Names live in fixed-size chunks that are never moved or freed, so name()
+ * can read them without locking: a chunk slot is written before its ID is
+ * published through count, and an ID is only obtained after that.
+ */
+struct Registry {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string_view, std::uint16_t> ids; // views into the chunks
+    std::unique_ptr<std::string[]> chunks[Category::MAX_COUNT / CHUNK_SIZE];
+    std::atomic<std::size_t> count{0};
+
+    Registry() {
+        for (std::string_view name : BUILTIN_NAMES) add(name);
+    }
+
+    /**
+     * @brief Store a new name and assign it the next ID. mutex must be held exclusively.
+     */
+    std::uint16_t add(std::string_view name) {
+        std::size_t id = count.load(std::memory_order_relaxed);
+        std::unique_ptr<std::string[]> &chunk = chunks[id / CHUNK_SIZE];
+        if (!chunk) chunk.reset(new std::string[CHUNK_SIZE]);
+        std::string &slot = chunk[id % CHUNK_SIZE];
+        slot.assign(name);
+        ids.emplace(slot, static_cast<std::uint16_t>(id));
+        count.store(id + 1, std::memory_order_release);
+        return static_cast<std::uint16_t>(id);
+    }
+};
+
+Registry &registry() {
+    static Registry instance;
+    return instance;
+}
+
+/**
+ * @brief Resolve a built-in name without touching the registry lock.
+ */
+bool findBuiltin(std::string_view name, std::uint16_t &id) {
+    for (std::size_t i = 0; i < Category::BUILTIN_COUNT; ++i) {
+        if (BUILTIN_NAMES[i] == name) {
+            id = static_cast<std::uint16_t>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+Category::Category() : id_(0) {}
+
+Category::Category(const char *name) : id_(intern(name != nullptr ? name : "").id_) {}
+
+Category::Category(const std::string &name) : id_(intern(name).id_) {}
+
+Category Category::intern(std::string_view name) {
+    Category category;
+    if (findBuiltin(name, category.id_)) return category;
+    Registry &r = registry();
+    {
+        std::shared_lock<std::shared_mutex> lock(r.mutex);
+        auto it = r.ids.find(name);
+        if (it != r.ids.end()) {
+            category.id_ = it->second;
+            return category;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(r.mutex);
+    auto it = r.ids.find(name); // another thread may have added it meanwhile
+    if (it != r.ids.end()) category.id_ = it->second;
+    else if (r.count.load(std::memory_order_relaxed) < MAX_COUNT) category.id_ = r.add(name);
+    else category.id_ = OTHER_ID;
+    return category;
+}
+
+bool Category::find(std::string_view name, Category &category) {
+    if (findBuiltin(name, category.id_)) return true;
+    Registry &r = registry();
+    std::shared_lock<std::shared_mutex> lock(r.mutex);
+    auto it = r.ids.find(name);
+    if (it == r.ids.end()) return false;
+    category.id_ = it->second;
+    return true;
+}
+
+Category Category::fromId(std::uint16_t id) {
+    Category category;
+    category.id_ = id < count() ? id : 0;
+    return category;
+}
+
+std::size_t Category::count() {
+    return registry().count.load(std::memory_order_acquire);
+}
+
+std::uint16_t Category::id() const {
+    return id_;
+}
+
+const std::string &Category::name() const {
+    return registry().chunks[id_ / CHUNK_SIZE][id_ % CHUNK_SIZE];
+}
+
+std::ostream &operator<<(std::ostream &os, Category category) {
+    return os << category.name();
+}
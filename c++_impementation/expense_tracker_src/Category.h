@@ -0,0 +1,115 @@
+#ifndef CATEGORY_H
+#define CATEGORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Expense category stored as a small integer ID into a process-wide registry.
+ *
+ * The registry starts with the uncategorized name "" (ID 0) and the seven
+ * built-in categories under their menu numbers (1 = Housing ... 7 = Other).
+ * Any other name met while loading a file is interned on first use and keeps
+ * its ID for the rest of the process. Comparing categories is an integer
+ * compare and the name is looked up only for display and saving.
+ *
+ * The registry is thread-safe: names can be interned from several loader
+ * threads at once, and name() never takes a lock.
+ *
+ * Construction from a name is implicit so expenses can still be written as
+ * {id, date, amount, "Housing", description}.
+ */
+class Category {
+public:
+    /**
+     * @brief Number of IDs reserved for "" and the built-in categories.
+     */
+    static const std::size_t BUILTIN_COUNT = 8;
+
+    /**
+     * @brief Largest number of distinct categories the registry can hold.
+     */
+    static const std::size_t MAX_COUNT = 65536;
+
+    /**
+     * @brief The uncategorized category "" (ID 0).
+     */
+    Category();
+
+    /**
+     * @brief The category with the given name, interning it if it is new.
+     * @param name The category name.
+     */
+    Category(const char *name);
+
+    /**
+     * @brief The category with the given name, interning it if it is new.
+     * @param name The category name.
+     */
+    Category(const std::string &name);
+
+    /**
+     * @brief The category with the given name, interning it if it is new.
+     *        Built-in names are resolved without taking a lock. Once the registry
+     *        is full, new names map to "Other".
+     * @param name The category name.
+     */
+    static Category intern(std::string_view name);
+
+    /**
+     * @brief Look up a category without interning it.
+     * @param name The category name.
+     * @param category Receives the category if it exists.
+     * @return True if the name is registered.
+     */
+    static bool find(std::string_view name, Category &category);
+
+    /**
+     * @brief The category with the given ID.
+     * @param id An ID below count().
+     */
+    static Category fromId(std::uint16_t id);
+
+    /**
+     * @brief Number of registered categories; every ID is below this value,
+     *        so it can size flat per-category arrays.
+     */
+    static std::size_t count();
+
+    /**
+     * @brief The category's ID.
+     */
+    std::uint16_t id() const;
+
+    /**
+     * @brief The category's name.
+     */
+    const std::string &name() const;
+
+    friend bool operator==(Category a, Category b) { return a.id_ == b.id_; }
+    friend bool operator!=(Category a, Category b) { return a.id_ != b.id_; }
+    friend bool operator<(Category a, Category b) { return a.id_ < b.id_; }
+
+    // Comparing against a name does not intern it
+    friend bool operator==(Category a, const std::string &b) { return a.name() == b; }
+    friend bool operator==(const std::string &a, Category b) { return a == b.name(); }
+    friend bool operator==(Category a, const char *b) { return a.name() == b; }
+    friend bool operator==(const char *a, Category b) { return a == b.name(); }
+    friend bool operator!=(Category a, const std::string &b) { return !(a == b); }
+    friend bool operator!=(const std::string &a, Category b) { return !(a == b); }
+    friend bool operator!=(Category a, const char *b) { return !(a == b); }
+    friend bool operator!=(const char *a, Category b) { return !(a == b); }
+
+private:
+    std::uint16_t id_;
+};
+
+/**
+ * @brief Write the category name, honoring the stream's field width.
+ */
+std::ostream &operator<<(std::ostream &os, Category category);
+
+#endif
@@ -0,0 +1,109 @@
+// Date.cpp - Calendar dates stored as day numbers
+#include "Date.h"
+#include <limits>
+#include <ostream>
+
+// Day number used for dates that failed to parse
+static const std::int32_t INVALID_DAYS = std::numeric_limits<std::int32_t>::min();
+
+Date::Date() : days_(INVALID_DAYS) {}
+
+Date::Date(const char *text) : days_(INVALID_DAYS) {
+    if (text != nullptr) parse(text, *this);
+}
+
+Date::Date(const std::string &text) : days_(INVALID_DAYS) {
+    parse(text, *this);
+}
+
+Date Date::fromDays(std::int32_t days) {
+    Date date;
+    date.days_ = days;
+    return date;
+}
+
+/**
+ * @brief Read a fixed number of decimal digits.
+ * @return The value, or -1 if a character is not a digit.
+ */
+static int readDigits(const char *p, int count) {
+    int value = 0;
+    for (int i = 0; i < count; ++i) {
+        if (p[i] < '0' || p[i] > '9') return -1;
+        value = value * 10 + (p[i] - '0');
+    }
+    return value;
+}
+
+/**
+ * @brief Validate YYYY-MM-DD and convert it with the proleptic Gregorian
+ *        calendar (days-from-civil).
+ */
+bool Date::parse(std::string_view text, Date &date) {
+    if (text.size() != TEXT_SIZE || text[4] != '-' || text[7] != '-') return false;
+    int y = readDigits(text.data(), 4);
+    int m = readDigits(text.data() + 5, 2);
+    int d = readDigits(text.data() + 8, 2);
+    if (y < 1900 || m < 1 || m > 12 || d < 1) return false;
+    static const int days_in_month[] = {31,28,31,30,31,30,31,31,30,31,30,31};
+    int maxd = days_in_month[m-1];
+    if (m == 2 && ((y%4==0 && y%100!=0) || (y%400==0))) maxd = 29;
+    if (d > maxd) return false;
+
+    unsigned um = static_cast<unsigned>(m);
+    y -= um <= 2;
+    int era = y / 400;
+    unsigned yoe = static_cast<unsigned>(y - era * 400);
+    unsigned doy = (153 * (um > 2 ? um - 3 : um + 9) + 2) / 5 + static_cast<unsigned>(d) - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    date.days_ = era * 146097 + static_cast<int>(doe) - 719468;
+    return true;
+}
+
+bool Date::isValid() const {
+    return days_ != INVALID_DAYS;
+}
+
+std::int32_t Date::days() const {
+    return days_;
+}
+
+/**
+ * @brief Convert the day number back to YYYY-MM-DD (civil-from-days).
+ */
+char *Date::format(char *out) const {
+    if (!isValid()) return out;
+    int days = days_ + 719468;
+    int era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned doe = static_cast<unsigned>(days - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int y = static_cast<int>(yoe) + era * 400;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    unsigned d = doy - (153 * mp + 2) / 5 + 1;
+    unsigned m = mp < 10 ? mp + 3 : mp - 9;
+    y += m <= 2;
+    // Years outside 0..9999 are clamped so the text form keeps its fixed width
+    unsigned uy = y < 0 ? 0 : (y > 9999 ? 9999 : static_cast<unsigned>(y));
+    out[0] = static_cast<char>('0' + uy / 1000);
+    out[1] = static_cast<char>('0' + uy / 100 % 10);
+    out[2] = static_cast<char>('0' + uy / 10 % 10);
+    out[3] = static_cast<char>('0' + uy % 10);
+    out[4] = '-';
+    out[5] = static_cast<char>('0' + m / 10);
+    out[6] = static_cast<char>('0' + m % 10);
+    out[7] = '-';
+    out[8] = static_cast<char>('0' + d / 10);
+    out[9] = static_cast<char>('0' + d % 10);
+    return out + TEXT_SIZE;
+}
+
+std::string Date::toString() const {
+    char buf[TEXT_SIZE];
+    return std::string(buf, format(buf));
+}
+
+std::ostream &operator<<(std::ostream &os, const Date &date) {
+    char buf[Date::TEXT_SIZE];
+    return os << std::string_view(buf, date.format(buf) - buf);
+}
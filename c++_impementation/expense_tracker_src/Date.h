@@ -0,0 +1,98 @@
+#ifndef DATE_H
+#define DATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Calendar date stored as a 32-bit day number (days since 1970-01-01).
+ *
+ * Dates are parsed from YYYY-MM-DD once, when an expense is added or loaded,
+ * and formatted back only for display and saving, so comparisons and range
+ * checks are plain integer compares. Text that is not a valid date yields an
+ * invalid Date; invalid dates compare equal to each other and before every
+ * valid date.
+ *
+ * Construction from text is implicit so expenses can still be written as
+ * {id, "2025-10-24", amount, category, description}.
+ */
+class Date {
+public:
+    /**
+     * @brief Length of the YYYY-MM-DD text form.
+     */
+    static const std::size_t TEXT_SIZE = 10;
+
+    /**
+     * @brief Create an invalid date.
+     */
+    Date();
+
+    /**
+     * @brief Parse a date in YYYY-MM-DD format; invalid if the text is not a real date.
+     * @param text The date text.
+     */
+    Date(const char *text);
+
+    /**
+     * @brief Parse a date in YYYY-MM-DD format; invalid if the text is not a real date.
+     * @param text The date text.
+     */
+    Date(const std::string &text);
+
+    /**
+     * @brief Create a date from a day number.
+     * @param days The number of days since 1970-01-01.
+     */
+    static Date fromDays(std::int32_t days);
+
+    /**
+     * @brief Parse a date in YYYY-MM-DD format (year 1900 or later).
+     * @param text The date text.
+     * @param date Receives the date; left unchanged on failure.
+     * @return True if the text is a valid date.
+     */
+    static bool parse(std::string_view text, Date &date);
+
+    /**
+     * @brief Whether the date holds a valid day.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Number of days since 1970-01-01.
+     */
+    std::int32_t days() const;
+
+    /**
+     * @brief Format the date as YYYY-MM-DD, or an empty string if it is invalid.
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Format the date as YYYY-MM-DD into a caller-provided buffer without allocating.
+     * @param out Buffer of at least TEXT_SIZE characters.
+     * @return Pointer past the last character written (out itself if the date is invalid).
+     */
+    char *format(char *out) const;
+
+    friend bool operator==(const Date &a, const Date &b) { return a.days_ == b.days_; }
+    friend bool operator!=(const Date &a, const Date &b) { return a.days_ != b.days_; }
+    friend bool operator<(const Date &a, const Date &b) { return a.days_ < b.days_; }
+    friend bool operator<=(const Date &a, const Date &b) { return a.days_ <= b.days_; }
+    friend bool operator>(const Date &a, const Date &b) { return a.days_ > b.days_; }
+    friend bool operator>=(const Date &a, const Date &b) { return a.days_ >= b.days_; }
+
+private:
+    std::int32_t days_;
+};
+
+/**
+ * @brief Write a date as YYYY-MM-DD, honoring the stream's field width.
+ */
+std::ostream &operator<<(std::ostream &os, const Date &date);
+
+#endif
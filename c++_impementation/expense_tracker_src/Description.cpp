@@ -0,0 +1,90 @@
+// Description.cpp - Shared, arena-backed expense descriptions
+#include "Description.h"
+#include <cstring>
+#include <ostream>
+#include <utility>
+
+Description::Description() : data_(""), size_(0) {}
+
+#ifdef EXPENSE_INLINE_DESCRIPTIONS
+Description::Description(const Description &other) : Description() {
+    *this = other;
+}
+
+Description &Description::operator=(const Description &other) {
+    if (this == &other) return *this;
+    owner_ = other.owner_;
+    if (other.isInline()) {
+        storeInline(other.view());
+    } else {
+        data_ = other.data_;
+        size_ = other.size_;
+    }
+    return *this;
+}
+
+void Description::storeInline(std::string_view text) {
+    std::memcpy(inline_, text.data(), text.size());
+    data_ = inline_;
+    size_ = static_cast<std::uint32_t>(text.size());
+    owner_.reset();
+}
+#endif
+
+Description::Description(const char *text) : Description() {
+    copy(text != nullptr ? text : "");
+}
+
+Description::Description(const std::string &text) : Description() {
+    copy(text);
+}
+
+Description::Description(std::string &&text) : Description() {
+    if (text.empty()) return;
+#ifdef EXPENSE_INLINE_DESCRIPTIONS
+    if (text.size() <= INLINE_CAPACITY) {
+        storeInline(text);
+        return;
+    }
+#endif
+    auto owned = std::make_shared<const std::string>(std::move(text));
+    data_ = owned->data();
+    size_ = static_cast<std::uint32_t>(owned->size());
+    owner_ = std::move(owned);
+}
+
+Description::Description(std::shared_ptr<const void> owner, std::string_view text) : Description() {
+    if (text.empty()) return;
+#ifdef EXPENSE_INLINE_DESCRIPTIONS
+    if (text.size() <= INLINE_CAPACITY) {
+        storeInline(text);
+        return;
+    }
+#endif
+    data_ = text.data();
+    size_ = static_cast<std::uint32_t>(text.size());
+    owner_ = std::move(owner);
+}
+
+void Description::copy(std::string_view text) {
+    if (text.empty()) return;
+#ifdef EXPENSE_INLINE_DESCRIPTIONS
+    if (text.size() <= INLINE_CAPACITY) {
+        storeInline(text);
+        return;
+    }
+#endif
+    *this = Description(std::string(text));
+}
+
+Description Description::inArena(const std::shared_ptr<StringArena> &arena, std::string_view text) {
+#ifdef EXPENSE_INLINE_DESCRIPTIONS
+    // Text that fits inline never touches the arena
+    if (text.size() <= INLINE_CAPACITY) return Description(nullptr, text);
+#endif
+    return Description(arena, arena->store(text));
+}
+
+std::ostream &operator<<(std::ostream &os, const Description &description) {
+    return os << description.view();
+}
@@ -0,0 +1,151 @@
+#ifndef DESCRIPTION_H
+#define DESCRIPTION_H
+
+#include "StringArena.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Longest description isValidDescription() accepts.
+ */
+constexpr std::size_t MAX_DESCRIPTION_LENGTH = 200;
+
+#ifndef EXPENSE_DESCRIPTION_INLINE_CAPACITY
+#define EXPENSE_DESCRIPTION_INLINE_CAPACITY MAX_DESCRIPTION_LENGTH
+#endif
+
+/**
+ * @brief Immutable expense description: a view of text bytes plus a shared
+ *        reference to whatever owns them.
+ *
+ * Loaders store descriptions in one StringArena per dataset (or point straight
+ * into a memory-mapped file), so loading a million expenses makes no
+ * per-record allocation, and dropping the records frees the whole arena at
+ * once when the last description referring to it goes away. Copying a
+ * description copies the view and bumps a reference count; the text is never
+ * duplicated.
+ *
+ * Construction from a string is implicit (the text is copied into a block of
+ * its own) so expenses can still be written as {id, date, amount, category, "Rent"}.
+ *
+ * Building with EXPENSE_INLINE_DESCRIPTIONS (make DESCRIPTION_LAYOUT=inline)
+ * selects the inline layout instead: text up to INLINE_CAPACITY bytes (by
+ * default MAX_DESCRIPTION_LENGTH, so every valid description) lives in a
+ * fixed buffer inside the description itself. Adding or loading a record then
+ * makes no allocation and takes no shared reference, and a copy is a memcpy of
+ * the text. Longer text falls back to the shared layout. The interface is the
+ * same in both layouts.
+ */
+class Description {
+public:
+#ifdef EXPENSE_INLINE_DESCRIPTIONS
+    static constexpr std::size_t INLINE_CAPACITY = EXPENSE_DESCRIPTION_INLINE_CAPACITY;
+#else
+    static constexpr std::size_t INLINE_CAPACITY = 0;
+#endif
+
+    /**
+     * @brief The empty description.
+     */
+    Description();
+
+#ifdef EXPENSE_INLINE_DESCRIPTIONS
+    // Inline text must be re-pointed at the copy's own buffer
+    Description(const Description &other);
+    Description &operator=(const Description &other);
+#endif
+
+    /**
+     * @brief Copy the given text into storage owned by this description.
+     * @param text The description text.
+     */
+    Description(const char *text);
+
+    /**
+     * @brief Copy the given text into storage owned by this description.
+     * @param text The description text.
+     */
+    Description(const std::string &text);
+
+    /**
+     * @brief Take over the given string as this description's storage.
+     * @param text The description text.
+     */
+    Description(std::string &&text);
+
+    /**
+     * @brief Refer to text kept alive by owner, without copying it.
+     * @param owner Object that owns the bytes (an arena, a mapped file, ...).
+     * @param text The description bytes, which must stay valid as long as owner lives.
+     */
+    Description(std::shared_ptr<const void> owner, std::string_view text);
+
+    /**
+     * @brief Copy text into an arena and refer to the copy.
+     * @param arena The arena that takes the bytes; it lives as long as any description using it.
+     * @param text The description text.
+     */
+    static Description inArena(const std::shared_ptr<StringArena> &arena, std::string_view text);
+
+    /**
+     * @brief Whether the text is stored inside the description rather than shared.
+     */
+    bool isInline() const { return size_ > 0 && !owner_; }
+
+    const char *data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief The text as a string view, valid while this description lives.
+     */
+    std::string_view view() const { return std::string_view(data_, size_); }
+    operator std::string_view() const { return view(); }
+
+    /**
+     * @brief The text as a std::string copy.
+     */
+    std::string str() const { return std::string(data_, size_); }
+
+    friend bool operator==(const Description &a, const Description &b) { return a.view() == b.view(); }
+    friend bool operator!=(const Description &a, const Description &b) { return !(a == b); }
+    friend bool operator==(const Description &a, const std::string &b) { return a.view() == b; }
+    friend bool operator==(const std::string &a, const Description &b) { return b == a; }
+    friend bool operator==(const Description &a, const char *b) { return a.view() == b; }
+    friend bool operator==(const char *a, const Description &b) { return b == a; }
+    friend bool operator!=(const Description &a, const std::string &b) { return !(a == b); }
+    friend bool operator!=(const std::string &a, const Description &b) { return !(a == b); }
+    friend bool operator!=(const Description &a, const char *b) { return !(a == b); }
+    friend bool operator!=(const char *a, const Description &b) { return !(a == b); }
+
+private:
+    /**
+     * @brief Copy text into storage owned by this description.
+     */
+    void copy(std::string_view text);
+
+#ifdef EXPENSE_INLINE_DESCRIPTIONS
+    /**
+     * @brief Copy text that fits into the inline buffer.
+     */
+    void storeInline(std::string_view text);
+#endif
+
+    const char *data_;
+    std::uint32_t size_;
+    std::shared_ptr<const void> owner_;
+#ifdef EXPENSE_INLINE_DESCRIPTIONS
+    char inline_[INLINE_CAPACITY];
+#endif
+};
+
+/**
+ * @brief Write the description text, honoring the stream's field width.
+ */
+std::ostream &operator<<(std::ostream &os, const Description &description);
+
+#endif
@@ -1,30 +1,28 @@
 // Expense.cpp - Core expense operations for the CLI Expense Tracker
 #include "Expense.h"
+#include "ExpenseTable.h"
 #include "Utils.h"
 #include <iomanip>
-#include <algorithm>
-#include <unordered_map>
 #include <sstream>
 
-// Global variable to assign unique IDs to expenses
-int nextID = 1;
-
 /**
  * @brief Prompt the user for all fields and add a new expense to the list.
  *        Handles input validation for category selection.
- * @param expenses Reference to the vector of all expenses.
+ * @param expenses Reference to the table of all expenses.
  */
-void addExpense(std::vector<Expense> &expenses) {
+void addExpense(ExpenseTable &expenses) {
     Expense e;
-    e.id = nextID++;
-    // Date validation
+    e.id = expenses.idAllocator().allocate();
+    // Date validation; the date is parsed once and kept as a day number
+    std::string dateStr;
     do {
         std::cout << "Enter date (YYYY-MM-DD): ";
-        std::getline(std::cin, e.date);
-        if (!isValidDate(e.date)) {
+        std::getline(std::cin, dateStr);
+        if (!isValidDate(dateStr)) {
             std::cout << "❌ Invalid date format or value. Please enter a valid date in YYYY-MM-DD format.\n";
         }
-    } while (!isValidDate(e.date));
+    } while (!isValidDate(dateStr));
+    e.date = dateStr;
 
     // Amount validation
     std::string amountStr;
@@ -35,7 +33,7 @@ void addExpense(std::vector<Expense> &expenses) {
             std::cout << "❌ Invalid amount. Please enter a positive number.\n";
         }
     } while (!isValidAmount(amountStr));
-    e.amount = std::stod(amountStr);
+    Money::parse(amountStr, e.amount);
 
     // Category validation (robust, string input)
     int catChoice = 0;
@@ -51,7 +49,9 @@ void addExpense(std::vector<Expense> &expenses) {
     e.category = getCategoryByNumber(catChoice);
 
     std::cout << "Enter description: ";
-    std::getline(std::cin, e.description);
+    std::string desc;
+    std::getline(std::cin, desc);
+    e.description = expenses.storeDescription(desc);
 
     expenses.push_back(e);
     std::cout << "\n✅ Expense added successfully! (ID: " << e.id << ")\n";
@@ -59,9 +59,9 @@ void addExpense(std::vector<Expense> &expenses) {
 
 /**
  * @brief Display all expenses in a formatted table with IDs, dates, amounts, categories, and descriptions.
- * @param expenses Const reference to the vector of all expenses.
+ * @param expenses Const reference to the table of all expenses.
  */
-void viewExpenses(const std::vector<Expense> &expenses, const std::string &currentDataFile) {
+void viewExpenses(const ExpenseTable &expenses, const std::string &currentDataFile) {
     if (expenses.empty()) {
         std::cout << "No expenses found.\n";
         return;
@@ -75,7 +75,7 @@ void viewExpenses(const std::vector<Expense> &expenses, const std::string &curre
     for (const auto &e : expenses) {
         std::cout << std::left << std::setw(5) << e.id
                   << std::setw(12) << e.date
-                  << std::setw(12) << std::fixed << std::setprecision(2) << e.amount
+                  << std::setw(12) << e.amount
                   << std::setw(25) << e.category
                   << e.description << "\n";
     }
@@ -83,15 +83,16 @@ void viewExpenses(const std::vector<Expense> &expenses, const std::string &curre
 
 /**
  * @brief Delete an expense by its unique ID, with user prompt and validation.
- * @param expenses Reference to the vector of all expenses.
+ * @param expenses Reference to the table of all expenses.
+ * @return The ID of the deleted expense, or 0 if nothing was deleted.
  */
-void deleteExpense(std::vector<Expense> &expenses) {
+std::int64_t deleteExpense(ExpenseTable &expenses) {
     if (expenses.empty()) {
         std::cout << "No expenses to delete.\n";
-        return;
+        return 0;
     }
     std::string idInput;
-    int id = 0;
+    std::int64_t id = 0;
     while (true) {
         std::cout << "Enter Expense ID to delete: ";
         std::getline(std::cin, idInput);
@@ -99,21 +100,20 @@ void deleteExpense(std::vector<Expense> &expenses) {
         if (ss >> id && id > 0) break;
         std::cout << "Invalid ID. Please enter a positive number.\n";
     }
-    auto it = std::find_if(expenses.begin(), expenses.end(),
-                           [id](const Expense &e) { return e.id == id; });
-    if (it != expenses.end()) {
-        expenses.erase(it);
+    // O(1) through the table's ID index
+    if (expenses.remove(id)) {
         std::cout << "✅ Expense with ID " << id << " deleted successfully.\n";
-    } else {
-        std::cout << "❌ Expense with ID " << id << " not found.\n";
+        return id;
     }
+    std::cout << "❌ Expense with ID " << id << " not found.\n";
+    return 0;
 }
 
 /**
  * @brief Prompt the user to select a category and display only matching expenses.
- * @param expenses Const reference to the vector of all expenses.
+ * @param expenses Const reference to the table of all expenses.
  */
-void filterByCategory(const std::vector<Expense> &expenses) {
+void filterByCategory(const ExpenseTable &expenses) {
     if (expenses.empty()) {
         std::cout << "No expenses available.\n";
         return;
@@ -134,24 +134,18 @@ void filterByCategory(const std::vector<Expense> &expenses) {
         return;
     }
     std::cout << "\nExpenses in category: " << cat << "\n";
-    bool found = false;
-    for (const auto &e : expenses) {
-        if (e.category == cat) {
-            std::cout << std::left << std::setw(5) << e.id
-                      << std::setw(12) << e.date
-                      << std::setw(12) << e.amount << e.description << "\n";
-            found = true;
-        }
-    }
-    if (!found) std::cout << "No expenses found in this category.\n";
+    // Read from the category's posting list and printed in place, without copying rows
+    ExpenseView matches = filterByCategory(expenses, cat);
+    matches.render(std::cout, false);
+    if (matches.empty()) std::cout << "No expenses found in this category.\n";
 }
 
 /**
- * @brief Prompt the user for a start and end date, and display expenses in that range.
+ * @brief Prompt the user for a start and end date, and display expenses in that range in date order.
  *        Dates are expected in YYYY-MM-DD format.
- * @param expenses Const reference to the vector of all expenses.
+ * @param expenses Const reference to the table of all expenses.
  */
-void filterByDateRange(const std::vector<Expense> &expenses) {
+void filterByDateRange(const ExpenseTable &expenses) {
     if (expenses.empty()) {
         std::cout << "No expenses available.\n";
         return;
@@ -171,47 +165,45 @@ void filterByDateRange(const std::vector<Expense> &expenses) {
             std::cout << "❌ Invalid date format or value. Please enter a valid date in YYYY-MM-DD format.\n";
         }
     } while (!isValidDate(end));
-    time_t startTime = parseDate(start);
-    time_t endTime = parseDate(end);
+    Date startDate(start);
+    Date endDate(end);
     std::cout << "\nExpenses between " << start << " and " << end << ":\n";
-    bool found = false;
-    for (const auto &e : expenses) {
-        time_t d = parseDate(e.date);
-        if (d >= startTime && d <= endTime) {
-            std::cout << std::left << std::setw(5) << e.id
-                      << std::setw(12) << e.date
-                      << std::setw(12) << e.amount
-                      << std::setw(25) << e.category
-                      << e.description << "\n";
-            found = true;
-        }
-    }
-    if (!found) std::cout << "No expenses found in this range.\n";
+    // Two binary searches in the date index, then a walk over the matching run in date order
+    ExpenseView matches = filterByDateRange(expenses, startDate, endDate);
+    matches.render(std::cout);
+    if (matches.empty()) std::cout << "No expenses found in this range.\n";
 }
 
 /**
  * @brief Print a summary report of total expenses and subtotals for each category.
- * @param expenses Const reference to the vector of all expenses.
+ * @param expenses Const reference to the table of all expenses.
  */
-void summaryReport(const std::vector<Expense> &expenses) {
+void summaryReport(const ExpenseTable &expenses) {
     if (expenses.empty()) {
         std::cout << "No expenses recorded.\n";
         return;
     }
 
-    std::unordered_map<std::string, double> totals;
-    double grandTotal = 0;
+    // Integer cents: the totals are exact whatever the order of the rows.
+    // Category IDs are small, so the totals live in a flat array indexed by ID.
+    std::vector<Money> totals(Category::count());
+    std::vector<bool> used(totals.size());
+    Money grandTotal;
 
-    for (const auto &e : expenses) {
-        totals[e.category] += e.amount;
-        grandTotal += e.amount;
+    const std::pmr::vector<Category> &categories = expenses.categories();
+    const std::pmr::vector<Money> &amounts = expenses.amounts();
+    for (std::size_t i = 0; i < categories.size(); ++i) {
+        if (!expenses.isLive(i)) continue;
+        totals[categories[i].id()] += amounts[i];
+        used[categories[i].id()] = true;
+        grandTotal += amounts[i];
     }
 
     std::cout << "\n------- Summary by Category -------\n";
-    for (const auto &pair : totals) {
-        std::cout << std::left << std::setw(25) << pair.first
-                  << "$" << std::fixed << std::setprecision(2)
-                  << pair.second << "\n";
+    for (std::size_t id = 0; id < totals.size(); ++id) {
+        if (!used[id]) continue;
+        std::cout << std::left << std::setw(25) << Category::fromId(static_cast<std::uint16_t>(id))
+                  << "$" << totals[id] << "\n";
     }
     std::cout << "-----------------------------------\n";
     std::cout << std::left << std::setw(25) << "Total"
@@ -1,6 +1,11 @@
 #ifndef EXPENSE_H
 #define EXPENSE_H
 
+#include "Category.h"
+#include "Date.h"
+#include "Description.h"
+#include "Money.h"
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -10,60 +15,58 @@
  *
  * Fields:
  *   - id: Unique identifier for the expense.
- *   - date: Date of the expense (YYYY-MM-DD).
- *   - amount: Amount spent.
- *   - category: Expense category.
- *   - description: Description of the expense.
+ *   - date: Date of the expense, held as a day number (written as YYYY-MM-DD).
+ *   - amount: Amount spent, held in integer cents.
+ *   - category: Expense category, held as an interned ID.
+ *   - description: Description of the expense, sharing storage with the rest of a loaded dataset.
  */
 struct Expense {
-    int id;
-    std::string date;
-    double amount;
-    std::string category;
-    std::string description;
+    std::int64_t id;
+    Date date;
+    Money amount;
+    Category category;
+    Description description;
 };
 
-/**
- * @brief Global variable to assign unique IDs to expenses.
- */
-extern int nextID;
+class ExpenseTable;
 
 // Expense-related function declarations
 /**
  * @brief Prompt the user for all fields and add a new expense to the list.
- * @param expenses Reference to the vector of all expenses.
+ * @param expenses Reference to the table of all expenses.
  */
-void addExpense(std::vector<Expense> &expenses);
+void addExpense(ExpenseTable &expenses);
 
 /**
  * @brief Display all expenses in a formatted table with IDs, dates, amounts, categories, and descriptions.
- * @param expenses Const reference to the vector of all expenses.
+ * @param expenses Const reference to the table of all expenses.
  */
-void viewExpenses(const std::vector<Expense> &expenses);
+void viewExpenses(const ExpenseTable &expenses);
 
 /**
  * @brief Delete an expense by its unique ID, with user prompt and validation.
- * @param expenses Reference to the vector of all expenses.
+ * @param expenses Reference to the table of all expenses.
+ * @return The ID of the deleted expense, or 0 if nothing was deleted.
  */
-void deleteExpense(std::vector<Expense> &expenses);
+std::int64_t deleteExpense(ExpenseTable &expenses);
 
 /**
  * @brief Prompt the user to select a category and display only matching expenses.
- * @param expenses Const reference to the vector of all expenses.
+ * @param expenses Const reference to the table of all expenses.
  */
-void filterByCategory(const std::vector<Expense> &expenses);
+void filterByCategory(const ExpenseTable &expenses);
 
 /**
  * @brief Prompt the user for a start and end date, and display expenses in that range.
  *        Dates are expected in YYYY-MM-DD format.
- * @param expenses Const reference to the vector of all expenses.
+ * @param expenses Const reference to the table of all expenses.
  */
-void filterByDateRange(const std::vector<Expense> &expenses);
+void filterByDateRange(const ExpenseTable &expenses);
 
 /**
  * @brief Print a summary report of total expenses and subtotals for each category.
- * @param expenses Const reference to the vector of all expenses.
+ * @param expenses Const reference to the table of all expenses.
  */
-void summaryReport(const std::vector<Expense> &expenses);
+void summaryReport(const ExpenseTable &expenses);
 
 #endif
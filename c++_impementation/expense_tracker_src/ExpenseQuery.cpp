@@ -0,0 +1,99 @@
+// ExpenseQuery.cpp - Multi-predicate expense queries over the table's indexes
+#include "ExpenseQuery.h"
+#include <algorithm>
+#include <utility>
+
+std::string QueryPlan::describe() const {
+    const char *name = source == DateIndex ? "date index" : source == CategoryIndex ? "category index" : "full scan";
+    return std::string(name) + " (" + std::to_string(candidates) + " candidates)";
+}
+
+ExpenseQuery &ExpenseQuery::between(Date first, Date last) {
+    hasDates_ = true;
+    first_ = first;
+    last_ = last;
+    return *this;
+}
+
+ExpenseQuery &ExpenseQuery::inCategory(Category category) {
+    if (category.id() >= wanted_.size()) wanted_.resize(category.id() + 1);
+    if (!wanted_[category.id()]) categories_.push_back(category);
+    wanted_[category.id()] = true;
+    return *this;
+}
+
+ExpenseQuery &ExpenseQuery::amountBetween(Money min, Money max) {
+    hasAmounts_ = true;
+    min_ = min;
+    max_ = max;
+    return *this;
+}
+
+ExpenseQuery &ExpenseQuery::descriptionContains(std::string text) {
+    text_ = std::move(text);
+    return *this;
+}
+
+QueryPlan ExpenseQuery::plan(const ExpenseTable &table) const {
+    QueryPlan best{QueryPlan::FullScan, table.slots()};
+    if (hasDates_) {
+        auto range = table.dateRange(first_, last_);
+        if (range.second - range.first <= best.candidates) best = {QueryPlan::DateIndex, range.second - range.first};
+    }
+    if (!categories_.empty()) {
+        std::size_t candidates = 0;
+        for (Category category : categories_) candidates += table.slotsIn(category).size();
+        if (candidates <= best.candidates) best = {QueryPlan::CategoryIndex, candidates};
+    }
+    return best;
+}
+
+bool ExpenseQuery::matches(const ExpenseTable &table, std::size_t slot) const {
+    return table.isLive(slot) && matchesExcept(table, slot, QueryPlan::FullScan);
+}
+
+/**
+ * @brief Check the predicates that the candidate source does not already guarantee,
+ *        cheapest first.
+ */
+bool ExpenseQuery::matchesExcept(const ExpenseTable &table, std::size_t slot, QueryPlan::Source covered) const {
+    if (hasDates_ && covered != QueryPlan::DateIndex) {
+        Date date = table.dates()[slot];
+        if (date < first_ || date > last_) return false;
+    }
+    if (!categories_.empty() && covered != QueryPlan::CategoryIndex) {
+        std::uint16_t id = table.categories()[slot].id();
+        if (id >= wanted_.size() || !wanted_[id]) return false;
+    }
+    if (hasAmounts_) {
+        Money amount = table.amounts()[slot];
+        if (amount < min_ || amount > max_) return false;
+    }
+    if (!text_.empty() && table.descriptions()[slot].view().find(text_) == std::string_view::npos) return false;
+    return true;
+}
+
+ExpenseView ExpenseQuery::run(const ExpenseTable &table, std::pmr::memory_resource *resource) const {
+    QueryPlan chosen = plan(table);
+    std::pmr::vector<std::size_t> out(resource != nullptr ? resource : table.resource());
+    auto consider = [&](std::size_t slot) {
+        if (table.isLive(slot) && matchesExcept(table, slot, chosen.source)) out.push_back(slot);
+    };
+    switch (chosen.source) {
+    case QueryPlan::DateIndex: {
+        auto range = table.dateRange(first_, last_);
+        for (std::size_t pos = range.first; pos < range.second; ++pos) consider(table.byDate()[pos]);
+        std::sort(out.begin(), out.end());
+        break;
+    }
+    case QueryPlan::CategoryIndex:
+        for (Category category : categories_)
+            for (std::size_t slot : table.slotsIn(category)) consider(slot);
+        if (categories_.size() > 1) std::sort(out.begin(), out.end());
+        break;
+    case QueryPlan::FullScan:
+        for (std::size_t slot = 0; slot < table.slots(); ++slot) consider(slot);
+        break;
+    }
+    return ExpenseView(table, std::move(out));
+}
@@ -0,0 +1,100 @@
+#ifndef EXPENSE_QUERY_H
+#define EXPENSE_QUERY_H
+
+#include "ExpenseTable.h"
+#include "ExpenseView.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How an ExpenseQuery will find its candidate rows.
+ */
+struct QueryPlan {
+    enum Source {
+        FullScan,      ///< Visit every slot of the table
+        DateIndex,     ///< Walk the date range in the table's date index
+        CategoryIndex  ///< Walk the posting lists of the wanted categories
+    };
+
+    Source source;
+    std::size_t candidates; ///< Slots the source will visit (tombstones included)
+
+    /**
+     * @brief Human-readable description, e.g. "category index (1200 candidates)".
+     */
+    std::string describe() const;
+};
+
+/**
+ * @brief Conjunction of predicates over expense rows, run against an ExpenseTable.
+ *
+ * A query combines any of: a date range, a set of categories, an amount range
+ * and a description substring. A row matches when it satisfies every
+ * predicate that was set; a query with none matches every row.
+ *
+ * plan() picks the most selective index available: the date index for a date
+ * range, the posting lists for a category set, or a full scan when neither
+ * predicate is set. Candidate counts come straight from the indexes (two
+ * binary searches, or the sizes of the posting lists), so planning costs
+ * O(log n). Only the chosen source's rows are visited; the other predicates
+ * are checked on each of them as residual filters, the cheapest columns
+ * first and the description last.
+ *
+ * Predicates are set with chained calls:
+ *     ExpenseQuery().between(Date("2025-01-01"), Date("2025-03-31")).inCategory("Food & Dining").run(table)
+ */
+class ExpenseQuery {
+public:
+    /**
+     * @brief Only rows dated within [first, last].
+     */
+    ExpenseQuery &between(Date first, Date last);
+
+    /**
+     * @brief Only rows in the given category; repeated calls build a set of accepted categories.
+     */
+    ExpenseQuery &inCategory(Category category);
+
+    /**
+     * @brief Only rows whose amount lies within [min, max].
+     */
+    ExpenseQuery &amountBetween(Money min, Money max);
+
+    /**
+     * @brief Only rows whose description contains the given text (case-sensitive).
+     */
+    ExpenseQuery &descriptionContains(std::string text);
+
+    /**
+     * @brief Choose the candidate source for the given table.
+     */
+    QueryPlan plan(const ExpenseTable &table) const;
+
+    /**
+     * @brief Whether the live row in the given slot satisfies every predicate.
+     */
+    bool matches(const ExpenseTable &table, std::size_t slot) const;
+
+    /**
+     * @brief The live rows that match, in table order.
+     * @param table The table to query.
+     * @param resource Source of the result's memory; null uses the table's resource.
+     */
+    ExpenseView run(const ExpenseTable &table, std::pmr::memory_resource *resource = nullptr) const;
+
+private:
+    bool matchesExcept(const ExpenseTable &table, std::size_t slot, QueryPlan::Source covered) const;
+
+    bool hasDates_ = false;
+    Date first_;
+    Date last_;
+    std::vector<Category> categories_;
+    std::vector<bool> wanted_; // category ID -> accepted, sized to the largest accepted ID
+    bool hasAmounts_ = false;
+    Money min_;
+    Money max_;
+    std::string text_;
+};
+
+#endif
@@ -0,0 +1,255 @@
+// ExpenseTable.cpp - Column-oriented expense store
+#include "ExpenseTable.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+const std::size_t ExpenseTable::npos;
+
+ExpenseTable::ExpenseTable(std::pmr::memory_resource *resource)
+    : ids_(resource), dates_(resource), amounts_(resource), categories_(resource),
+      descriptions_(resource), live_(resource), slotOf_(resource), byDate_(resource),
+      byCategory_(resource), text_(resource) {}
+
+ExpenseTable::ExpenseTable(const std::vector<Expense> &expenses, std::pmr::memory_resource *resource)
+    : ExpenseTable(resource) {
+    reserve(expenses.size());
+    for (const auto &e : expenses) append(e);
+    rebuildDateIndex();
+}
+
+void ExpenseTable::reserve(std::size_t rows) {
+    slotOf_.reserve(rows);
+    ids_.reserve(rows);
+    dates_.reserve(rows);
+    amounts_.reserve(rows);
+    categories_.reserve(rows);
+    descriptions_.reserve(rows);
+    live_.reserve(rows);
+    byDate_.reserve(rows);
+}
+
+void ExpenseTable::clear() {
+    ids_.clear();
+    dates_.clear();
+    amounts_.clear();
+    categories_.clear();
+    descriptions_.clear();
+    live_.clear();
+    tombstones_ = 0;
+    slotOf_.clear();
+    duplicateIds_ = 0;
+    byDate_.clear();
+    byCategory_.clear();
+    text_.clear();
+    arena_.reset(); // descriptions still in use keep their text alive
+}
+
+void ExpenseTable::assign(std::vector<Expense> &&expenses) {
+    clear();
+    reserve(expenses.size());
+    for (auto &e : expenses) {
+        ids_.push_back(e.id);
+        dates_.push_back(e.date);
+        amounts_.push_back(e.amount);
+        categories_.push_back(e.category);
+        descriptions_.push_back(std::move(e.description));
+        live_.push_back(1);
+        index(ids_.size() - 1);
+    }
+    expenses.clear();
+    rebuildDateIndex();
+}
+
+void ExpenseTable::push_back(const Expense &e) {
+    append(e);
+    insertByDate(slots() - 1);
+}
+
+/**
+ * @brief Append a row to the columns and the ID index, but not to the date index.
+ */
+void ExpenseTable::append(const Expense &e) {
+    ids_.push_back(e.id);
+    dates_.push_back(e.date);
+    amounts_.push_back(e.amount);
+    categories_.push_back(e.category);
+    descriptions_.push_back(e.description);
+    live_.push_back(1);
+    index(ids_.size() - 1);
+}
+
+Description ExpenseTable::storeDescription(std::string_view text) {
+    if (!arena_) arena_ = std::make_shared<StringArena>(DEFAULT_ARENA_CHUNK_BYTES, resource());
+    return Description::inArena(arena_, text);
+}
+
+ExpenseTable::const_iterator ExpenseTable::begin() const {
+    std::size_t slot = 0;
+    while (slot < slots() && !isLive(slot)) ++slot;
+    return const_iterator(this, slot);
+}
+
+void ExpenseTable::erase(std::size_t slot) {
+    unindex(slot);
+    live_[slot] = 0;
+    descriptions_[slot] = Description(); // release the text now rather than at compaction
+    ++tombstones_;
+}
+
+bool ExpenseTable::needsCompaction(double ratio) const {
+    return tombstones_ > 0 && static_cast<double>(tombstones_) >= ratio * static_cast<double>(slots());
+}
+
+void ExpenseTable::compact() {
+    if (tombstones_ == 0) return;
+    std::vector<std::size_t> newSlot(slots(), npos);
+    std::size_t out = 0;
+    for (std::size_t slot = 0; slot < slots(); ++slot) {
+        if (!live_[slot]) continue;
+        newSlot[slot] = out;
+        if (out != slot) {
+            ids_[out] = ids_[slot];
+            dates_[out] = dates_[slot];
+            amounts_[out] = amounts_[slot];
+            categories_[out] = categories_[slot];
+            descriptions_[out] = std::move(descriptions_[slot]);
+            live_[out] = 1;
+            auto it = slotOf_.find(ids_[out]);
+            if (it != slotOf_.end() && it->second == slot) it->second = out;
+        }
+        ++out;
+    }
+    ids_.resize(out);
+    dates_.resize(out);
+    amounts_.resize(out);
+    categories_.resize(out);
+    descriptions_.resize(out);
+    live_.resize(out);
+    tombstones_ = 0;
+
+    // Live slots keep their relative order, so renumbering keeps the date index sorted
+    std::size_t kept = 0;
+    for (std::size_t slot : byDate_)
+        if (newSlot[slot] != npos) byDate_[kept++] = newSlot[slot];
+    byDate_.resize(kept);
+    for (auto &list : byCategory_) {
+        kept = 0;
+        for (std::size_t slot : list)
+            if (newSlot[slot] != npos) list[kept++] = newSlot[slot];
+        list.resize(kept);
+    }
+    text_.remap(newSlot);
+}
+
+std::pair<std::size_t, std::size_t> ExpenseTable::dateRange(Date first, Date last) const {
+    auto begin = std::lower_bound(byDate_.begin(), byDate_.end(), first,
+                                  [this](std::size_t slot, Date date) { return dates_[slot] < date; });
+    auto end = std::upper_bound(begin, byDate_.end(), last,
+                                [this](Date date, std::size_t slot) { return date < dates_[slot]; });
+    return {static_cast<std::size_t>(begin - byDate_.begin()), static_cast<std::size_t>(end - byDate_.begin())};
+}
+
+SlotBitmap ExpenseTable::dateBitmap(Date first, Date last) const {
+    SlotBitmap bits(slots());
+    auto range = dateRange(first, last);
+    for (std::size_t pos = range.first; pos < range.second; ++pos)
+        if (live_[byDate_[pos]]) bits.set(byDate_[pos]);
+    return bits;
+}
+
+const std::pmr::vector<std::size_t> &ExpenseTable::slotsIn(Category category) const {
+    static const std::pmr::vector<std::size_t> none;
+    return category.id() < byCategory_.size() ? byCategory_[category.id()] : none;
+}
+
+SlotBitmap ExpenseTable::categoryBitmap(Category category) const {
+    SlotBitmap bits(slots());
+    for (std::size_t slot : slotsIn(category))
+        if (live_[slot]) bits.set(slot);
+    return bits;
+}
+
+std::size_t ExpenseTable::find(std::int64_t id) const {
+    auto it = slotOf_.find(id);
+    return it == slotOf_.end() ? npos : it->second;
+}
+
+bool ExpenseTable::remove(std::int64_t id) {
+    std::size_t slot = find(id);
+    if (slot == npos) return false;
+    erase(slot);
+    return true;
+}
+
+/**
+ * @brief Add the newly appended row at slot to the ID index, its category's
+ *        posting list and the word index, and keep the allocator past its ID.
+ */
+void ExpenseTable::index(std::size_t slot) {
+    idAllocator_.observe(ids_[slot]);
+    if (!slotOf_.emplace(ids_[slot], slot).second) ++duplicateIds_;
+    std::uint16_t category = categories_[slot].id();
+    if (category >= byCategory_.size()) byCategory_.resize(category + 1);
+    byCategory_[category].push_back(slot);
+    text_.add(slot, descriptions_[slot].view());
+}
+
+/**
+ * @brief Drop the row at slot from the ID index. If other rows share its ID
+ *        (only possible with duplicate IDs), one of them takes over the entry.
+ */
+void ExpenseTable::unindex(std::size_t slot) {
+    auto it = slotOf_.find(ids_[slot]);
+    if (it == slotOf_.end() || it->second != slot) {
+        --duplicateIds_;
+        return;
+    }
+    slotOf_.erase(it);
+    if (duplicateIds_ == 0) return;
+    for (std::size_t i = 0; i < ids_.size(); ++i) {
+        if (i != slot && live_[i] && ids_[i] == ids_[slot]) {
+            slotOf_.emplace(ids_[i], i);
+            --duplicateIds_;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Add a newly appended slot to the date index; the common in-order append is O(1).
+ */
+void ExpenseTable::insertByDate(std::size_t slot) {
+    Date date = dates_[slot];
+    if (byDate_.empty() || !(date < dates_[byDate_.back()])) {
+        byDate_.push_back(slot);
+        return;
+    }
+    auto pos = std::upper_bound(byDate_.begin(), byDate_.end(), date,
+                                [this](Date d, std::size_t s) { return d < dates_[s]; });
+    byDate_.insert(pos, slot);
+}
+
+/**
+ * @brief Rebuild the date index from scratch after a bulk load.
+ */
+void ExpenseTable::rebuildDateIndex() {
+    byDate_.resize(slots());
+    std::iota(byDate_.begin(), byDate_.end(), std::size_t(0));
+    auto earlier = [this](std::size_t a, std::size_t b) { return dates_[a] < dates_[b]; };
+    // Ledgers are usually saved in date order already; stable keeps ties in slot order
+    if (!std::is_sorted(byDate_.begin(), byDate_.end(), earlier))
+        std::stable_sort(byDate_.begin(), byDate_.end(), earlier);
+}
+
+Expense ExpenseTable::row(std::size_t slot) const {
+    return Expense{ids_[slot], dates_[slot], amounts_[slot], categories_[slot], descriptions_[slot]};
+}
+
+std::vector<Expense> ExpenseTable::toVector() const {
+    std::vector<Expense> out;
+    out.reserve(size());
+    for (std::size_t i = 0; i < slots(); ++i)
+        if (live_[i]) out.push_back(row(i));
+    return out;
+}
@@ -0,0 +1,318 @@
+#ifndef EXPENSE_TABLE_H
+#define EXPENSE_TABLE_H
+
+#include "Expense.h"
+#include "IdAllocator.h"
+#include "SlotBitmap.h"
+#include "StringArena.h"
+#include "TextIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Share of dead slots above which an expense table should be compacted.
+ */
+const double DEFAULT_TOMBSTONE_RATIO = 0.25;
+
+/**
+ * @brief Expense store laid out as one contiguous column per field (struct of arrays).
+ *
+ * A scan that needs only dates or amounts walks a dense array of 4- or 8-byte
+ * values instead of dragging whole Expense records through the cache, so
+ * totals and filters run at memory bandwidth.
+ *
+ * A hash index from expense ID to slot is kept up to date on every change, so
+ * finding or deleting an expense by ID is O(1) on average. IDs are expected to
+ * be unique; if a file holds duplicates, find() returns one of them.
+ *
+ * A delete only marks the row's slot as a tombstone: nothing moves, so a mass
+ * delete costs O(k), row order is kept, and slots and iterators held by other
+ * readers stay valid. Scans, iteration and saves skip tombstones. compact()
+ * squeezes them out (keeping row order) and is run by the owner once
+ * needsCompaction() reports too many dead slots, or when the table is saved.
+ *
+ * A second index, byDate(), lists the slots in date order (ties in slot
+ * order). A date-range query is two binary searches followed by a walk over
+ * a contiguous run, so a month-to-date view of a decade-long ledger touches
+ * only that month's rows. Loading sorts the index once. Appending a row in
+ * date order is O(1); a back-dated row is inserted in place. Like the
+ * columns, the index keeps tombstoned slots until compaction, so readers
+ * skip dead slots.
+ *
+ * Each category also has a posting list, slotsIn(), of the slots holding it
+ * in ascending order, so a category filter touches only matching rows. New
+ * rows are appended to the list, and compaction renumbers it. categoryBitmap()
+ * and dateBitmap() turn index results into SlotBitmaps of live slots, which
+ * combine with a word-wide AND (e.g. one category in one month).
+ *
+ * textIndex() maps every word of the descriptions to the slots containing it.
+ * It is filled as rows are loaded or added and renumbered by compaction.
+ *
+ * The table owns the IdAllocator for new rows. Every row that enters the
+ * table (pushed, assigned or loaded) is observed by it, so IDs it hands out
+ * never collide with existing ones.
+ *
+ * Columns, the ID index and the text of descriptions added through
+ * storeDescription() are allocated from the table's std::pmr::memory_resource
+ * (the default resource unless one is given): a monotonic_buffer_resource
+ * makes a read-only reporting job's allocations near free, a pool resource
+ * suits a long interactive session. The resource must outlive the table and
+ * every description taken from it. A copy of a table uses the default
+ * resource, like any pmr container.
+ *
+ * Iterating yields each live row as an Expense value, so code written against
+ * std::vector<Expense> (for (const auto &e : expenses) ...) works unchanged.
+ * Hot loops should read the columns directly instead, checking isLive() for
+ * each slot; the columns have slots() entries.
+ */
+class ExpenseTable {
+public:
+    /**
+     * @brief Bidirectional iterator over the live rows, yielding each one as an Expense value.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Expense;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Expense;
+
+        const_iterator() : table_(nullptr), slot_(0) {}
+        const_iterator(const ExpenseTable *table, std::size_t slot) : table_(table), slot_(slot) {}
+
+        Expense operator*() const { return table_->row(slot_); }
+
+        /**
+         * @brief Slot of the current row in the table's columns.
+         */
+        std::size_t slot() const { return slot_; }
+
+        const_iterator &operator++() {
+            do ++slot_; while (slot_ < table_->slots() && !table_->isLive(slot_));
+            return *this;
+        }
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        const_iterator &operator--() {
+            do --slot_; while (!table_->isLive(slot_));
+            return *this;
+        }
+        const_iterator operator--(int) { const_iterator old = *this; --*this; return old; }
+        friend bool operator==(const_iterator a, const_iterator b) { return a.slot_ == b.slot_; }
+        friend bool operator!=(const_iterator a, const_iterator b) { return a.slot_ != b.slot_; }
+
+    private:
+        const ExpenseTable *table_;
+        std::size_t slot_;
+    };
+
+    /**
+     * @brief Returned by find() when no row has the requested ID.
+     */
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    ExpenseTable() : ExpenseTable(std::pmr::get_default_resource()) {}
+
+    /**
+     * @brief Create an empty table that allocates from the given resource.
+     * @param resource Source of the memory for columns, index and stored descriptions.
+     */
+    explicit ExpenseTable(std::pmr::memory_resource *resource);
+
+    /**
+     * @brief Build a table holding the given expenses in order.
+     * @param expenses The rows to copy in.
+     * @param resource Source of the memory for columns, index and stored descriptions.
+     */
+    explicit ExpenseTable(const std::vector<Expense> &expenses,
+                          std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    /**
+     * @brief The memory resource this table allocates from.
+     */
+    std::pmr::memory_resource *resource() const { return ids_.get_allocator().resource(); }
+
+    /**
+     * @brief Copy text into the table's own arena, for rows about to be added.
+     * @param text The description text.
+     * @return A description whose bytes come from resource().
+     */
+    Description storeDescription(std::string_view text);
+
+    /**
+     * @brief Number of live rows.
+     */
+    std::size_t size() const { return ids_.size() - tombstones_; }
+    bool empty() const { return size() == 0; }
+    const_iterator begin() const;
+    const_iterator end() const { return const_iterator(this, slots()); }
+
+    /**
+     * @brief Number of slots in each column, live or not.
+     */
+    std::size_t slots() const { return ids_.size(); }
+
+    /**
+     * @brief Whether the slot holds a live row rather than a tombstone.
+     */
+    bool isLive(std::size_t slot) const { return live_[slot] != 0; }
+
+    /**
+     * @brief Number of deleted rows still occupying a slot.
+     */
+    std::size_t tombstones() const { return tombstones_; }
+
+    /**
+     * @brief Whether the share of tombstones has reached the given ratio.
+     */
+    bool needsCompaction(double ratio = DEFAULT_TOMBSTONE_RATIO) const;
+
+    /**
+     * @brief Remove all tombstones, keeping the order of the live rows.
+     *        Slots of live rows change, so outstanding slots and iterators become invalid.
+     */
+    void compact();
+
+    /**
+     * @brief Reserve room for the given number of rows in every column.
+     */
+    void reserve(std::size_t rows);
+
+    /**
+     * @brief Remove all rows.
+     */
+    void clear();
+
+    /**
+     * @brief Replace the contents with the given expenses, moving their descriptions.
+     * @param expenses The rows to take over; left empty.
+     */
+    void assign(std::vector<Expense> &&expenses);
+
+    /**
+     * @brief Append a row.
+     * @param e The expense to append.
+     */
+    void push_back(const Expense &e);
+
+    /**
+     * @brief Delete the live row in the given slot in O(1) by turning it into a tombstone.
+     * @param slot Slot of a live row.
+     */
+    void erase(std::size_t slot);
+
+    /**
+     * @brief Slot of the live row with the given ID.
+     * @param id The expense ID.
+     * @return The slot, or npos if no live row has this ID.
+     */
+    std::size_t find(std::int64_t id) const;
+
+    /**
+     * @brief Whether a live row has the given ID.
+     */
+    bool contains(std::int64_t id) const { return find(id) != npos; }
+
+    /**
+     * @brief Remove the row with the given ID in O(1), see erase().
+     * @param id The expense ID.
+     * @return True if a row was removed.
+     */
+    bool remove(std::int64_t id);
+
+    /**
+     * @brief Positions in byDate() of the slots dated within [first, last], found by binary search.
+     * @param first The earliest date wanted.
+     * @param last The latest date wanted.
+     * @return The half-open range [begin, end) of positions; empty if last < first.
+     *         Tombstoned slots in it must be skipped.
+     */
+    std::pair<std::size_t, std::size_t> dateRange(Date first, Date last) const;
+
+    /**
+     * @brief Live slots dated within [first, last], as a bitmap over slots().
+     */
+    SlotBitmap dateBitmap(Date first, Date last) const;
+
+    /**
+     * @brief Every slot, live or not, holding the given category, in ascending order.
+     */
+    const std::pmr::vector<std::size_t> &slotsIn(Category category) const;
+
+    /**
+     * @brief Live slots holding the given category, as a bitmap over slots().
+     */
+    SlotBitmap categoryBitmap(Category category) const;
+
+    /**
+     * @brief Word index over the descriptions of every slot, live or not.
+     */
+    const TextIndex &textIndex() const { return text_; }
+
+    /**
+     * @brief The allocator for IDs of new rows in this table.
+     */
+    IdAllocator &idAllocator() { return idAllocator_; }
+
+    /**
+     * @brief Assemble the row in the given slot.
+     * @param slot A slot below slots().
+     */
+    Expense row(std::size_t slot) const;
+
+    /**
+     * @brief The last live row; the table must not be empty.
+     */
+    Expense back() const { return *--end(); }
+
+    /**
+     * @brief Copy the live rows out in order, e.g. for the file savers.
+     */
+    std::vector<Expense> toVector() const;
+
+    // Read-only column access for scans; slot i of every column belongs to the
+    // same row, and live()[i] is 0 for a tombstone
+    const std::pmr::vector<std::uint8_t> &live() const { return live_; }
+    const std::pmr::vector<std::int64_t> &ids() const { return ids_; }
+    const std::pmr::vector<Date> &dates() const { return dates_; }
+    const std::pmr::vector<Money> &amounts() const { return amounts_; }
+    const std::pmr::vector<Category> &categories() const { return categories_; }
+    const std::pmr::vector<Description> &descriptions() const { return descriptions_; }
+
+    /**
+     * @brief Every slot, live or not, ordered by date and then by slot.
+     */
+    const std::pmr::vector<std::size_t> &byDate() const { return byDate_; }
+
+private:
+    std::pmr::vector<std::int64_t> ids_;
+    std::pmr::vector<Date> dates_;
+    std::pmr::vector<Money> amounts_;
+    std::pmr::vector<Category> categories_;
+    std::pmr::vector<Description> descriptions_;
+    std::pmr::vector<std::uint8_t> live_;
+    std::size_t tombstones_ = 0;
+
+    void append(const Expense &e);
+    void index(std::size_t slot);
+    void unindex(std::size_t slot);
+    void insertByDate(std::size_t slot);
+    void rebuildDateIndex();
+
+    IdAllocator idAllocator_;
+    std::pmr::unordered_map<std::int64_t, std::size_t> slotOf_; // expense ID -> slot of its live row
+    std::size_t duplicateIds_ = 0;                      // rows whose ID another row already holds
+    std::shared_ptr<StringArena> arena_;                // text of added rows, created on first use
+    std::pmr::vector<std::size_t> byDate_;              // slots sorted by (date, slot)
+    std::pmr::vector<std::pmr::vector<std::size_t>> byCategory_; // category ID -> its slots, ascending
+    TextIndex text_;                                             // description words -> slots
+};
+
+#endif
@@ -0,0 +1,41 @@
+// ExpenseView.cpp - Zero-copy filter and query results
+#include "ExpenseView.h"
+#include <iomanip>
+#include <ostream>
+#include <utility>
+
+ExpenseView::ExpenseView(const ExpenseTable &table, std::pmr::memory_resource *resource)
+    : table_(&table), slots_(resource != nullptr ? resource : table.resource()) {}
+
+ExpenseView::ExpenseView(const ExpenseTable &table, std::pmr::vector<std::size_t> slots)
+    : table_(&table), slots_(std::move(slots)) {}
+
+ExpenseRef ExpenseView::operator[](std::size_t pos) const {
+    std::size_t slot = slots_[pos];
+    return ExpenseRef{table_->ids()[slot], table_->dates()[slot], table_->amounts()[slot],
+                      table_->categories()[slot], table_->descriptions()[slot]};
+}
+
+Money ExpenseView::total() const {
+    const std::pmr::vector<Money> &amounts = table_->amounts();
+    std::int64_t cents = 0;
+    for (std::size_t slot : slots_) cents += amounts[slot].cents();
+    return Money::fromCents(cents);
+}
+
+void ExpenseView::render(std::ostream &os, bool withCategory) const {
+    for (const ExpenseRef e : *this) {
+        os << std::left << std::setw(5) << e.id
+           << std::setw(12) << e.date
+           << std::setw(12) << e.amount;
+        if (withCategory) os << std::setw(25) << e.category;
+        os << e.description << "\n";
+    }
+}
+
+std::vector<Expense> ExpenseView::toVector() const {
+    std::vector<Expense> out;
+    out.reserve(slots_.size());
+    for (const ExpenseRef e : *this) out.push_back(e);
+    return out;
+}
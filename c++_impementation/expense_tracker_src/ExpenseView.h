@@ -0,0 +1,132 @@
+#ifndef EXPENSE_VIEW_H
+#define EXPENSE_VIEW_H
+
+#include "ExpenseTable.h"
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief One table row seen in place: each field refers into the table's column.
+ *
+ * Reads like an Expense (e.id, e.date, e.description, ...) but copies
+ * nothing; convert to Expense to keep the row beyond the table's lifetime.
+ */
+struct ExpenseRef {
+    const std::int64_t &id;
+    const Date &date;
+    const Money &amount;
+    const Category &category;
+    const Description &description;
+
+    operator Expense() const { return Expense{id, date, amount, category, description}; }
+};
+
+/**
+ * @brief Result of a filter or query: the list of matching slots of a table.
+ *
+ * A view stores one slot number per matching row instead of a copy of the
+ * row, so a wide result costs 8 bytes per row and building it touches only
+ * the columns the filter reads. Rows are read through the table on access,
+ * as ExpenseRef, and total() sums the amount column for the listed slots.
+ *
+ * A view refers to its table and is valid until the table is compacted,
+ * cleared or destroyed; rows deleted after the view was made are still
+ * listed. The slot list is allocated from the table's memory resource
+ * unless another one is given.
+ */
+class ExpenseView {
+public:
+    /**
+     * @brief Bidirectional iterator over the listed rows, yielding each as an ExpenseRef.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = ExpenseRef;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ExpenseRef;
+
+        const_iterator() : view_(nullptr), pos_(0) {}
+        const_iterator(const ExpenseView *view, std::size_t pos) : view_(view), pos_(pos) {}
+
+        ExpenseRef operator*() const { return (*view_)[pos_]; }
+
+        /**
+         * @brief Slot of the current row in the table's columns.
+         */
+        std::size_t slot() const { return view_->slots()[pos_]; }
+
+        const_iterator &operator++() { ++pos_; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++pos_; return old; }
+        const_iterator &operator--() { --pos_; return *this; }
+        const_iterator operator--(int) { const_iterator old = *this; --pos_; return old; }
+        friend bool operator==(const_iterator a, const_iterator b) { return a.pos_ == b.pos_; }
+        friend bool operator!=(const_iterator a, const_iterator b) { return a.pos_ != b.pos_; }
+
+    private:
+        const ExpenseView *view_;
+        std::size_t pos_;
+    };
+
+    /**
+     * @brief An empty view of the table.
+     * @param table The table the slots refer to.
+     * @param resource Source of the slot list's memory; null uses the table's resource.
+     */
+    explicit ExpenseView(const ExpenseTable &table, std::pmr::memory_resource *resource = nullptr);
+
+    /**
+     * @brief A view of the given slots of the table, in the given order.
+     */
+    ExpenseView(const ExpenseTable &table, std::pmr::vector<std::size_t> slots);
+
+    /**
+     * @brief Append a slot to the view.
+     */
+    void push_back(std::size_t slot) { slots_.push_back(slot); }
+
+    std::size_t size() const { return slots_.size(); }
+    bool empty() const { return slots_.empty(); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slots_.size()); }
+
+    /**
+     * @brief The row at the given position of the view.
+     */
+    ExpenseRef operator[](std::size_t pos) const;
+
+    /**
+     * @brief The listed slots, in view order.
+     */
+    const std::pmr::vector<std::size_t> &slots() const { return slots_; }
+
+    const ExpenseTable &table() const { return *table_; }
+    std::pmr::memory_resource *resource() const { return slots_.get_allocator().resource(); }
+
+    /**
+     * @brief Exact sum of the amounts of the listed rows.
+     */
+    Money total() const;
+
+    /**
+     * @brief Write the listed rows, one per line, in the layout of the expense listing.
+     * @param os The stream to write to.
+     * @param withCategory Whether to include the category column.
+     */
+    void render(std::ostream &os, bool withCategory = true) const;
+
+    /**
+     * @brief Copy the listed rows out as Expense values.
+     */
+    std::vector<Expense> toVector() const;
+
+private:
+    const ExpenseTable *table_;
+    std::pmr::vector<std::size_t> slots_;
+};
+
+#endif
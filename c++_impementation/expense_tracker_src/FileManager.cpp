@@ -1,14 +1,17 @@
 #include "FileManager.h"
-#include <fstream>
-#include <sstream>
-#include <iomanip>
+#include "BinaryStore.h"
+#include "BlockStore.h"
+#include "MappedFile.h"
+#include "BufferedWriter.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+#include <thread>
 #include "json.hpp" // Use local header for nlohmann/json
 
 using json = nlohmann::json;
 
-// Global variable for unique expense IDs (defined elsewhere)
-extern int nextID;
-
 /**
  * @brief Save all expenses to a CSV file (expenses.csv).
  *
@@ -19,27 +22,75 @@ void saveExpensesCSV(const std::vector<Expense> &expenses) {
     saveExpensesCSV(expenses, "expenses.csv");
 }
 
+/**
+ * @brief Write one expense as a CSV row, numbers formatted with std::to_chars.
+ */
+static void writeCSVExpense(BufferedWriter &out, const Expense &e) {
+    char num[32];
+    out.write(std::string_view(num, std::to_chars(num, num + sizeof(num), e.id).ptr - num));
+    out.put(',');
+    char date[Date::TEXT_SIZE];
+    out.write(std::string_view(date, e.date.format(date) - date));
+    out.put(',');
+    out.write(std::string_view(num, e.amount.format(num) - num));
+    out.put(',');
+    out.write(e.category.name());
+    out.put(',');
+    out.write(e.description);
+    out.put('\n');
+}
+
 /**
  * @brief Save all expenses to a CSV file with a specified filename.
  *
  * @param expenses Const reference to the vector of all expenses.
  * @param filename The name of the file to save the expenses to.
- * Writes each expense as a row in the CSV file with headers.
+ * Writes each expense as a row in the CSV file with headers. The new file replaces
+ * the old one atomically, so a crash mid-save never leaves a truncated ledger.
  */
 void saveExpensesCSV(const std::vector<Expense> &expenses, const std::string &filename) {
-    std::ofstream out(filename);
-    out << "ID,Date,Amount,Category,Description\n";
-    for (const auto &e : expenses) {
-        out << e.id << "," << e.date << "," << e.amount << ","
-            << e.category << "," << e.description << "\n";
+    BufferedWriter out;
+    if (!out.open(filename)) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return;
+    }
+    out.write("ID,Date,Amount,Category,Description\n");
+    for (const auto &e : expenses) writeCSVExpense(out, e);
+    if (!out.close()) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return;
     }
-    out.close();
     std::cout << "✅ Expenses saved to " << filename << "\n";
 }
 
+/**
+ * @brief Append expenses to the end of an existing CSV file.
+ *
+ * @param expenses Const reference to the expenses to append.
+ * @param filename The name of the CSV file to append to.
+ * @return True if the rows were appended; false if the file is missing or does not
+ *         end with a complete row, in which case nothing was written.
+ */
+bool appendExpensesCSV(const std::vector<Expense> &expenses, const std::string &filename) {
+    std::size_t size = 0;
+    {
+        MappedFile file;
+        if (!file.open(filename) || file.size() == 0 || file.data()[file.size() - 1] != '\n') return false;
+        size = file.size();
+    }
+    BufferedWriter out;
+    if (!out.openInPlace(filename, size)) return false;
+    for (const auto &e : expenses) writeCSVExpense(out, e);
+    if (!out.close()) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return false;
+    }
+    std::cout << "✅ Expenses saved to " << filename << "\n";
+    return true;
+}
+
 /**
  * @brief Load expenses from a CSV file (expenses.csv) into the expenses vector.
- *        Updates nextID to ensure unique IDs for new expenses.
  * @param expenses Reference to the vector of all expenses.
  * Reads each row and parses fields into Expense objects.
  */
@@ -47,38 +98,166 @@ void loadExpensesCSV(std::vector<Expense> &expenses) {
     loadExpensesCSV(expenses, "expenses.csv");
 }
 
+/**
+ * @brief Split off the next comma-separated field of a CSV row.
+ *
+ * @param rest The unparsed remainder of the row; advanced past the comma.
+ * @param field Receives the field.
+ * @return False if there is no further comma.
+ */
+static bool nextCSVField(std::string_view &rest, std::string_view &field) {
+    const char *comma = static_cast<const char *>(std::memchr(rest.data(), ',', rest.size()));
+    if (comma == nullptr) return false;
+    field = rest.substr(0, comma - rest.data());
+    rest.remove_prefix(field.size() + 1);
+    return true;
+}
+
+/**
+ * @brief Parse one CSV data row in place.
+ *
+ * @param row The row without its trailing newline.
+ * @param e The Expense to fill.
+ * @param description Receives the description field; only valid on success.
+ * @return True if the row was well-formed.
+ */
+static bool parseCSVFields(std::string_view row, Expense &e, std::string_view &description) {
+    if (!row.empty() && row.back() == '\r') row.remove_suffix(1);
+    std::string_view idStr, dateStr, amountStr, categoryStr;
+    if (!nextCSVField(row, idStr) || !nextCSVField(row, dateStr) ||
+        !nextCSVField(row, amountStr) || !nextCSVField(row, categoryStr))
+        return false;
+    auto idRes = std::from_chars(idStr.data(), idStr.data() + idStr.size(), e.id);
+    if (idRes.ec != std::errc() || idRes.ptr != idStr.data() + idStr.size()) return false;
+    if (!Money::parse(amountStr, e.amount)) return false;
+    if (!Date::parse(dateStr, e.date)) return false;
+    e.category = Category::intern(categoryStr);
+    description = row;
+    return true;
+}
+
+/**
+ * @brief Parse one CSV data row, copying the description into storage of its own.
+ */
+bool parseExpenseCSVRow(std::string_view row, Expense &e) {
+    std::string_view description;
+    if (!parseCSVFields(row, e, description)) return false;
+    e.description = std::string(description);
+    return true;
+}
+
+/**
+ * @brief Parse one CSV data row, copying the description into a shared arena.
+ */
+bool parseExpenseCSVRow(std::string_view row, Expense &e, const std::shared_ptr<StringArena> &arena) {
+    std::string_view description;
+    if (!parseCSVFields(row, e, description)) return false;
+    e.description = Description::inArena(arena, description);
+    return true;
+}
+
+/**
+ * @brief Rows parsed from one chunk of a CSV file.
+ */
+struct CSVChunk {
+    std::vector<Expense> expenses;
+    std::shared_ptr<StringArena> arena; // descriptions of this chunk
+    std::size_t skipped = 0;
+};
+
+/**
+ * @brief Parse every row in a range of CSV data that starts at a row boundary.
+ *
+ * @param data The rows to parse (header already removed).
+ * @param chunk Receives the parsed rows and the malformed row count.
+ */
+static void parseCSVChunk(std::string_view data, CSVChunk &chunk) {
+    chunk.expenses.reserve(std::count(data.begin(), data.end(), '\n') + 1);
+    Expense e;
+    while (!data.empty()) {
+        const char *nl = static_cast<const char *>(std::memchr(data.data(), '\n', data.size()));
+        std::size_t len = nl ? static_cast<std::size_t>(nl - data.data()) : data.size();
+        std::string_view row = data.substr(0, len);
+        data.remove_prefix(nl ? len + 1 : len);
+        if (row.empty() || row == "\r") continue;
+        if (!parseExpenseCSVRow(row, e, chunk.arena)) {
+            ++chunk.skipped;
+            continue;
+        }
+        chunk.expenses.push_back(e);
+    }
+}
+
 /**
  * @brief Load expenses from a CSV file with a specified filename into the expenses vector.
- *        Updates nextID to ensure unique IDs for new expenses.
  * @param expenses Reference to the vector of all expenses.
  * @param filename The name of the file to load the expenses from.
- * Reads each row and parses fields into Expense objects.
+ * Large files are parsed in parallel on all available cores.
  */
 void loadExpensesCSV(std::vector<Expense> &expenses, const std::string &filename) {
+    loadExpensesCSV(expenses, filename, 0);
+}
+
+/**
+ * @brief Load expenses from a CSV file using the given number of parser threads.
+ * @param expenses Reference to the vector of all expenses.
+ * @param filename The name of the file to load the expenses from.
+ * @param threads Number of parser threads; 0 picks one per core for large files.
+ * @param resource Upstream of each chunk's description arena.
+ * Maps the file, splits it into newline-aligned byte ranges, parses each range on
+ * its own thread, and stitches the results back together in file order.
+ */
+void loadExpensesCSV(std::vector<Expense> &expenses, const std::string &filename, unsigned threads,
+                     std::pmr::memory_resource *resource) {
     expenses.clear();
-    std::ifstream in(filename);
-    if (!in.is_open()) {
+    MappedFile file;
+    if (!file.open(filename)) {
         std::cout << "❌ No CSV file found: " << filename << "\n";
         return;
     }
-    std::string line;
-    getline(in, line); // skip header
-    while (getline(in, line)) {
-        std::stringstream ss(line);
-        Expense e;
-        std::string idStr, amountStr;
-        getline(ss, idStr, ',');
-        getline(ss, e.date, ',');
-        getline(ss, amountStr, ',');
-        getline(ss, e.category, ',');
-        getline(ss, e.description);
-        e.id = stoi(idStr);
-        e.amount = stod(amountStr);
-        expenses.push_back(e);
-        if (e.id >= nextID)
-            nextID = e.id + 1;
-    }
-    in.close();
+    std::string_view data = file.view();
+    std::size_t headerEnd = data.find('\n');
+    data.remove_prefix(headerEnd == std::string_view::npos ? data.size() : headerEnd + 1); // skip header
+
+    if (threads == 0)
+        threads = data.size() < PARALLEL_CSV_MIN_BYTES ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, data.size() / 4096 + 1));
+
+    // Split into byte ranges that each begin right after a newline
+    std::vector<std::string_view> ranges;
+    std::size_t begin = 0;
+    for (unsigned t = 1; t <= threads && begin < data.size(); ++t) {
+        std::size_t end = data.size();
+        if (t < threads) {
+            end = data.find('\n', std::max(begin, data.size() / threads * t));
+            end = end == std::string_view::npos ? data.size() : end + 1;
+        }
+        ranges.push_back(data.substr(begin, end - begin));
+        begin = end;
+    }
+
+    std::vector<CSVChunk> chunks(ranges.size());
+    for (auto &chunk : chunks) chunk.arena = std::make_shared<StringArena>(DEFAULT_ARENA_CHUNK_BYTES, resource);
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < ranges.size(); ++i)
+        workers.emplace_back(parseCSVChunk, ranges[i], std::ref(chunks[i]));
+    if (!ranges.empty()) parseCSVChunk(ranges[0], chunks[0]);
+    for (auto &worker : workers) worker.join();
+
+    std::size_t total = 0, skipped = 0;
+    for (const auto &chunk : chunks) {
+        total += chunk.expenses.size();
+        skipped += chunk.skipped;
+    }
+    if (chunks.size() == 1) {
+        expenses = std::move(chunks[0].expenses);
+    } else {
+        expenses.reserve(total);
+        for (auto &chunk : chunks)
+            std::move(chunk.expenses.begin(), chunk.expenses.end(), std::back_inserter(expenses));
+    }
+    if (skipped > 0)
+        std::cout << "❌ Skipped " << skipped << " malformed row(s) in " << filename << "\n";
     std::cout << "✅ Expenses loaded from " << filename << "\n";
 }
 
@@ -93,31 +272,212 @@ void saveExpensesJSON(const std::vector<Expense> &expenses) {
 }
 
 /**
- * @brief Save all expenses to a JSON file with a specified filename using nlohmann::json.
+ * @brief Save all expenses to a JSON file with a specified filename, pretty-printed.
  *
  * @param expenses Const reference to the vector of all expenses.
  * @param filename The name of the file to save the expenses to.
  * Serializes all expenses as an array of objects in JSON format.
  */
 void saveExpensesJSON(const std::vector<Expense> &expenses, const std::string &filename) {
-    json jExpenses = json::array();
+    saveExpensesJSON(expenses, filename, JsonStyle::Pretty);
+}
+
+/**
+ * @brief Length of the valid UTF-8 sequence starting at s[i], or 0 if it is invalid.
+ */
+static std::size_t utf8SequenceLength(std::string_view s, std::size_t i) {
+    auto byte = [&](std::size_t k) { return static_cast<unsigned char>(s[k]); };
+    auto in = [&](std::size_t k, unsigned lo, unsigned hi) {
+        return k < s.size() && byte(k) >= lo && byte(k) <= hi;
+    };
+    unsigned char c = byte(i);
+    if (c >= 0xC2 && c <= 0xDF) return in(i + 1, 0x80, 0xBF) ? 2 : 0;
+    if (c == 0xE0) return in(i + 1, 0xA0, 0xBF) && in(i + 2, 0x80, 0xBF) ? 3 : 0;
+    if ((c >= 0xE1 && c <= 0xEC) || c == 0xEE || c == 0xEF)
+        return in(i + 1, 0x80, 0xBF) && in(i + 2, 0x80, 0xBF) ? 3 : 0;
+    if (c == 0xED) return in(i + 1, 0x80, 0x9F) && in(i + 2, 0x80, 0xBF) ? 3 : 0;
+    if (c == 0xF0) return in(i + 1, 0x90, 0xBF) && in(i + 2, 0x80, 0xBF) && in(i + 3, 0x80, 0xBF) ? 4 : 0;
+    if (c >= 0xF1 && c <= 0xF3)
+        return in(i + 1, 0x80, 0xBF) && in(i + 2, 0x80, 0xBF) && in(i + 3, 0x80, 0xBF) ? 4 : 0;
+    if (c == 0xF4) return in(i + 1, 0x80, 0x8F) && in(i + 2, 0x80, 0xBF) && in(i + 3, 0x80, 0xBF) ? 4 : 0;
+    return 0;
+}
+
+/**
+ * @brief Write a JSON string literal with the required escapes.
+ *
+ * Valid UTF-8 is copied through unchanged; invalid bytes are replaced with
+ * U+FFFD so the output always parses.
+ */
+static void writeJSONString(BufferedWriter &out, std::string_view s) {
+    static const char hex[] = "0123456789abcdef";
+    out.put('"');
+    std::size_t runStart = 0;
+    std::size_t i = 0;
+    while (i < s.size()) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c >= 0x20 && c != '"' && c != '\\' && c < 0x80) {
+            ++i;
+            continue;
+        }
+        if (c >= 0x80) {
+            std::size_t len = utf8SequenceLength(s, i);
+            if (len > 0) {
+                i += len;
+                continue;
+            }
+        }
+        out.write(s.substr(runStart, i - runStart));
+        switch (c) {
+            case '"': out.write("\\\""); break;
+            case '\\': out.write("\\\\"); break;
+            case '\b': out.write("\\b"); break;
+            case '\f': out.write("\\f"); break;
+            case '\n': out.write("\\n"); break;
+            case '\r': out.write("\\r"); break;
+            case '\t': out.write("\\t"); break;
+            default:
+                if (c >= 0x80) {
+                    out.write("\\ufffd");
+                } else {
+                    char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                    out.write(std::string_view(esc, sizeof(esc)));
+                }
+        }
+        runStart = ++i;
+    }
+    out.write(s.substr(runStart));
+    out.put('"');
+}
+
+/**
+ * @brief Write an amount as a JSON number in its shortest exact form, keeping a ".0" on whole numbers.
+ */
+static void writeJSONNumber(BufferedWriter &out, Money value) {
+    char buf[Money::MAX_TEXT_SIZE];
+    std::string_view text(buf, value.format(buf) - buf);
+    out.write(text);
+    if (text.find('.') == std::string_view::npos) out.write(".0");
+}
+
+/**
+ * @brief Write an integer JSON number.
+ */
+static void writeJSONNumber(BufferedWriter &out, int value) {
+    char buf[16];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.write(std::string_view(buf, res.ptr - buf));
+}
+
+/**
+ * @brief Write one expense as a JSON object with keys in sorted order.
+ *
+ * @param out The output sink.
+ * @param e The expense to write.
+ * @param pretty Whether to indent the object as an array element.
+ */
+static void writeJSONExpense(BufferedWriter &out, const Expense &e, bool pretty) {
+    const char *open = pretty ? "    {\n        \"amount\": " : "{\"amount\":";
+    const char *sep = pretty ? ",\n        \"" : ",\"";
+    const char *colon = pretty ? "\": " : "\":";
+    out.write(open);
+    writeJSONNumber(out, e.amount);
+    out.write(sep); out.write("category"); out.write(colon);
+    writeJSONString(out, e.category.name());
+    out.write(sep); out.write("date"); out.write(colon);
+    char date[Date::TEXT_SIZE];
+    out.put('"');
+    out.write(std::string_view(date, e.date.format(date) - date));
+    out.put('"');
+    out.write(sep); out.write("description"); out.write(colon);
+    writeJSONString(out, e.description);
+    out.write(sep); out.write("id"); out.write(colon);
+    writeJSONNumber(out, e.id);
+    out.write(pretty ? "\n    }" : "}");
+}
+
+/**
+ * @brief Save all expenses to a JSON file in the given layout.
+ *
+ * @param expenses Const reference to the vector of all expenses.
+ * @param filename The name of the file to save the expenses to.
+ * @param style Pretty (4-space indented) or compact output.
+ * Streams each expense straight into a buffered file sink instead of building a JSON document.
+ */
+void saveExpensesJSON(const std::vector<Expense> &expenses, const std::string &filename, JsonStyle style) {
+    BufferedWriter out;
+    if (!out.open(filename)) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return;
+    }
+    bool pretty = style == JsonStyle::Pretty;
+    out.put('[');
+    for (std::size_t i = 0; i < expenses.size(); ++i) {
+        if (i > 0) out.put(',');
+        if (pretty) out.put('\n');
+        writeJSONExpense(out, expenses[i], pretty);
+    }
+    if (pretty && !expenses.empty()) out.put('\n');
+    out.put(']');
+    if (!out.close()) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return;
+    }
+    std::cout << "✅ Expenses saved to " << filename << "\n";
+}
+
+/**
+ * @brief Append expenses to an existing JSON array by seeking back over its closing ']'.
+ *
+ * Only the tail of the file is inspected and rewritten, so the cost does not depend on
+ * the file size. The layout of the existing file (pretty or compact) is kept.
+ *
+ * @param expenses Const reference to the expenses to append.
+ * @param filename The name of the JSON file to append to.
+ * @return True if the records were appended; false if the file does not end with a
+ *         JSON array of objects, in which case nothing was written.
+ */
+bool appendExpensesJSON(const std::vector<Expense> &expenses, const std::string &filename) {
+    std::size_t offset = 0;
+    bool first = false;
+    bool pretty = false;
+    {
+        MappedFile file;
+        if (!file.open(filename)) return false;
+        std::string_view data = file.view();
+        auto isSpace = [](char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; };
+        std::size_t end = data.size();
+        while (end > 0 && isSpace(data[end - 1])) --end;
+        if (end == 0 || data[end - 1] != ']') return false;
+        std::size_t last = end - 1;
+        while (last > 0 && isSpace(data[last - 1])) --last;
+        if (last == 0) return false;
+        char c = data[last - 1];
+        if (c != '[' && c != '}') return false;
+        first = c == '[';
+        pretty = !first && data.substr(last, end - 1 - last).find('\n') != std::string_view::npos;
+        offset = last;
+    }
+    BufferedWriter out;
+    if (!out.openInPlace(filename, offset)) return false;
     for (const auto &e : expenses) {
-        jExpenses.push_back({
-            {"id", e.id},
-            {"date", e.date},
-            {"amount", e.amount},
-            {"category", e.category},
-            {"description", e.description}
-        });
-    }
-    std::ofstream file(filename);
-    file << std::setw(4) << jExpenses;
+        if (!first) out.put(',');
+        first = false;
+        if (pretty) out.put('\n');
+        writeJSONExpense(out, e, pretty);
+    }
+    if (pretty) out.put('\n');
+    out.put(']');
+    if (!out.close()) {
+        std::cout << "❌ Could not write " << filename << "\n";
+        return false;
+    }
     std::cout << "✅ Expenses saved to " << filename << "\n";
+    return true;
 }
 
 /**
  * @brief Load expenses from a JSON file (expenses.json) into the expenses vector.
- *        Updates nextID to ensure unique IDs for new expenses.
  * @param expenses Reference to the vector of all expenses.
  * Reads and parses the JSON array, handling errors gracefully.
  */
@@ -125,37 +485,205 @@ void loadExpensesJSON(std::vector<Expense> &expenses) {
     loadExpensesJSON(expenses, "expenses.json");
 }
 
+/**
+ * @brief SAX handler that builds Expense records directly from a JSON array of objects.
+ *
+ * Only the record being parsed and the current key are held in memory; each
+ * Expense is appended as soon as its object closes, so no DOM is ever built.
+ * Any structural problem or missing/mistyped field aborts the parse.
+ */
+class ExpenseSaxHandler final : public nlohmann::json_sax<json> {
+public:
+    ExpenseSaxHandler(std::vector<Expense> &expenses, std::pmr::memory_resource *resource)
+        : expenses_(expenses), arena_(std::make_shared<StringArena>(DEFAULT_ARENA_CHUNK_BYTES, resource)) {}
+
+    bool null() override { return scalar(); }
+    bool boolean(bool) override { return scalar(); }
+    bool binary(binary_t &) override { return scalar(); }
+
+    bool number_integer(number_integer_t val) override { return number(static_cast<double>(val), val); }
+    bool number_unsigned(number_unsigned_t val) override {
+        return number(static_cast<double>(val), static_cast<number_integer_t>(val));
+    }
+    bool number_float(number_float_t val, const string_t &text) override {
+        // Amounts are read from the number's text, so no binary rounding creeps in
+        Money amount;
+        if (!Money::parse(text, amount)) amount = val;
+        return number(amount, static_cast<number_integer_t>(val));
+    }
+
+    bool string(string_t &val) override {
+        if (depth_ != 2) return depth_ > 2;
+        switch (field_) {
+            case Date:
+                if (!::Date::parse(val, current_.date)) return false;
+                break;
+            case Category: current_.category = ::Category::intern(val); break;
+            case Description: current_.description = ::Description::inArena(arena_, val); break;
+            case Unknown: return true;
+            default: return false; // id/amount must be numbers
+        }
+        seen_ |= field_;
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        ++depth_;
+        if (depth_ == 1) return false; // top level must be an array
+        if (depth_ == 2) {
+            seen_ = 0;
+            field_ = Unknown;
+        }
+        return true;
+    }
+
+    bool key(string_t &val) override {
+        if (depth_ != 2) return true;
+        if (val == "id") field_ = Id;
+        else if (val == "date") field_ = Date;
+        else if (val == "amount") field_ = Amount;
+        else if (val == "category") field_ = Category;
+        else if (val == "description") field_ = Description;
+        else field_ = Unknown;
+        return true;
+    }
+
+    bool end_object() override {
+        if (depth_-- != 2) return true;
+        if (seen_ != AllFields) return false;
+        expenses_.push_back(std::move(current_));
+        current_ = Expense();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        ++depth_;
+        if (depth_ == 2) return false; // records must be objects
+        return true;
+    }
+
+    bool end_array() override {
+        --depth_;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override {
+        return false;
+    }
+
+private:
+    enum Field { Unknown = 0, Id = 1, Date = 2, Amount = 4, Category = 8, Description = 16, AllFields = 31 };
+
+    /** A value that is neither a string nor a number. */
+    bool scalar() {
+        if (depth_ != 2) return depth_ > 2;
+        return field_ == Unknown;
+    }
+
+    bool number(Money val, number_integer_t intVal) {
+        if (depth_ != 2) return depth_ > 2;
+        switch (field_) {
+            case Id: current_.id = intVal; break;
+            case Amount: current_.amount = val; break;
+            case Unknown: return true;
+            default: return false; // date/category/description must be strings
+        }
+        seen_ |= field_;
+        return true;
+    }
+
+    std::vector<Expense> &expenses_;
+    std::shared_ptr<StringArena> arena_;
+    Expense current_{};
+    int depth_ = 0;
+    Field field_ = Unknown;
+    int seen_ = 0;
+};
+
 /**
  * @brief Load expenses from a JSON file with a specified filename into the expenses vector.
- *        Updates nextID to ensure unique IDs for new expenses.
  * @param expenses Reference to the vector of all expenses.
  * @param filename The name of the file to load the expenses from.
- * Reads and parses the JSON array, handling errors gracefully.
+ * @param resource Upstream of the description arena.
+ * Streams the mapped file through a SAX parser, building each Expense as its
+ * object closes; on any error the list is left empty.
  */
-void loadExpensesJSON(std::vector<Expense> &expenses, const std::string &filename) {
+void loadExpensesJSON(std::vector<Expense> &expenses, const std::string &filename,
+                      std::pmr::memory_resource *resource) {
     expenses.clear();
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+    MappedFile file;
+    if (!file.open(filename)) {
         std::cout << "❌ No JSON file found: " << filename << "\n";
         return;
     }
-    try {
-        json jExpenses;
-        file >> jExpenses;
-        for (const auto &item : jExpenses) {
-            Expense e;
-            item.at("id").get_to(e.id);
-            item.at("date").get_to(e.date);
-            item.at("amount").get_to(e.amount);
-            item.at("category").get_to(e.category);
-            item.at("description").get_to(e.description);
-            expenses.push_back(e);
-            if (e.id >= nextID)
-                nextID = e.id + 1;
-        }
-    } catch (const json::exception &) {
+    ExpenseSaxHandler handler(expenses, resource);
+    std::string_view data = file.view();
+    if (!json::sax_parse(data.begin(), data.end(), &handler)) {
         expenses.clear();
         std::cout << "❌ Error parsing JSON file: " << filename << "\n";
     }
     std::cout << "✅ Expenses loaded from " << filename << "\n";
 }
+
+/**
+ * @brief Save all expenses to a file, choosing the format from the file type.
+ *        JSON is written compactly since this is used for persistent files.
+ *
+ * @param expenses Const reference to the vector of all expenses.
+ * @param filename The name of the file to save the expenses to.
+ * @param fileType The file type ("csv", "json", "expb" or "expz").
+ */
+void saveExpenses(const std::vector<Expense> &expenses, const std::string &filename, const std::string &fileType) {
+    if (fileType == "csv") saveExpensesCSV(expenses, filename);
+    else if (fileType == "json") saveExpensesJSON(expenses, filename, JsonStyle::Compact);
+    else if (fileType == "expb") saveExpensesBinary(expenses, filename);
+    else if (fileType == "expz") saveExpensesBlocks(expenses, filename);
+}
+
+/**
+ * @brief Append expenses to an existing file without rewriting it.
+ * @param expenses Const reference to the expenses to append.
+ * @param filename The name of the file to append to.
+ * @param fileType The file type; only "csv" and "json" files can be appended to.
+ * @return True if the expenses were appended, false if the file must be rewritten instead.
+ */
+bool appendExpenses(const std::vector<Expense> &expenses, const std::string &filename, const std::string &fileType) {
+    if (fileType == "csv") return appendExpensesCSV(expenses, filename);
+    if (fileType == "json") return appendExpensesJSON(expenses, filename);
+    return false;
+}
+
+/**
+ * @brief Load expenses from a file, choosing the format from the file type.
+ * @param expenses Reference to the vector of all expenses.
+ * @param filename The name of the file to load the expenses from.
+ * @param fileType The file type ("csv", "json", "expb" or "expz").
+ * @param resource Upstream of the CSV and JSON description arenas.
+ */
+void loadExpenses(std::vector<Expense> &expenses, const std::string &filename, const std::string &fileType,
+                  std::pmr::memory_resource *resource) {
+    if (fileType == "csv") loadExpensesCSV(expenses, filename, 0, resource);
+    else if (fileType == "json") loadExpensesJSON(expenses, filename, resource);
+    else if (fileType == "expb") loadExpensesBinary(expenses, filename);
+    else if (fileType == "expz") loadExpensesBlocks(expenses, filename);
+}
+
+/**
+ * @brief Save an expense table, choosing the format from the file type.
+ *        The writers work on rows, so the table is read out row by row first;
+ *        descriptions are shared, not copied.
+ */
+void saveExpenses(const ExpenseTable &expenses, const std::string &filename, const std::string &fileType) {
+    saveExpenses(expenses.toVector(), filename, fileType);
+}
+
+/**
+ * @brief Load a file into an expense table, choosing the format from the file type.
+ *        The table's ID allocator moves past the largest loaded ID, and CSV
+ *        and JSON descriptions come from the table's memory resource.
+ */
+void loadExpenses(ExpenseTable &expenses, const std::string &filename, const std::string &fileType) {
+    std::vector<Expense> loaded;
+    loadExpenses(loaded, filename, fileType, expenses.resource());
+    expenses.assign(std::move(loaded));
+}
@@ -2,8 +2,25 @@
 #define FILE_MANAGER_H
 
 #include "Expense.h"
+#include "ExpenseTable.h"
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include <string>
+#include <string_view>
+
+/**
+ * @brief Layout used when writing JSON files.
+ *
+ * Pretty output (4-space indentation) is meant for human-facing exports;
+ * compact output is used for machine-owned persistent files.
+ */
+enum class JsonStyle { Pretty, Compact };
+
+/**
+ * @brief CSV files at least this large are parsed in parallel by default.
+ */
+const std::size_t PARALLEL_CSV_MIN_BYTES = 4 * 1024 * 1024;
 
 /**
  * @brief Saves the list of expenses to a CSV file.
@@ -44,11 +61,63 @@ void saveExpensesCSV(const std::vector<Expense> &expenses, const std::string &fi
 /**
  * @brief Loads expenses from a CSV file with a custom filename into the provided vector.
  *
+ * The file is memory-mapped and scanned in place; malformed rows are skipped.
+ * Files of at least PARALLEL_CSV_MIN_BYTES are parsed on all available cores.
+ *
  * @param expenses The vector to populate with loaded Expense objects.
  * @param filename The name of the file to load the expenses from.
  */
 void loadExpensesCSV(std::vector<Expense> &expenses, const std::string &filename);
 
+/**
+ * @brief Loads expenses from a CSV file using several parser threads.
+ *
+ * The mapped file is split into byte ranges aligned on newline boundaries that
+ * are parsed concurrently; rows are kept in file order.
+ *
+ * @param expenses The vector to populate with loaded Expense objects.
+ * @param filename The name of the file to load the expenses from.
+ * @param threads Number of parser threads; 0 uses one per core for files of at
+ *                least PARALLEL_CSV_MIN_BYTES and a single thread otherwise.
+ * @param resource Upstream of the arenas holding the loaded descriptions; it
+ *                 must outlive them.
+ */
+void loadExpensesCSV(std::vector<Expense> &expenses, const std::string &filename, unsigned threads,
+                     std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+/**
+ * @brief Parses one CSV data row ("id,date,amount,category,description") in place.
+ *
+ * Numeric fields are converted with std::from_chars directly from the row bytes;
+ * the description is everything after the fourth comma. A trailing '\r' is ignored.
+ *
+ * @param row The row without its trailing newline.
+ * @param e The Expense to fill.
+ * @return True if the row was well-formed.
+ */
+bool parseExpenseCSVRow(std::string_view row, Expense &e);
+
+/**
+ * @brief Parses one CSV data row, storing the description in a shared arena.
+ *
+ * Used by the bulk loaders so parsed rows make no per-row allocation.
+ *
+ * @param row The row without its trailing newline.
+ * @param e The Expense to fill.
+ * @param arena The arena that receives the description bytes.
+ * @return True if the row was well-formed.
+ */
+bool parseExpenseCSVRow(std::string_view row, Expense &e, const std::shared_ptr<StringArena> &arena);
+
+/**
+ * @brief Appends expenses to the end of an existing CSV file without rewriting it.
+ *
+ * @param expenses The vector of Expense objects to append.
+ * @param filename The name of the CSV file to append to.
+ * @return True if the rows were appended.
+ */
+bool appendExpensesCSV(const std::vector<Expense> &expenses, const std::string &filename);
+
 /**
  * @brief Saves the list of expenses to a JSON file with a custom filename.
  *
@@ -57,12 +126,93 @@ void loadExpensesCSV(std::vector<Expense> &expenses, const std::string &filename
  */
 void saveExpensesJSON(const std::vector<Expense> &expenses, const std::string &filename);
 
+/**
+ * @brief Saves the list of expenses to a JSON file in the given layout.
+ *
+ * Records are serialized one at a time straight into a buffered file sink.
+ *
+ * @param expenses The vector of Expense objects to be saved.
+ * @param filename The name of the file to save the expenses to.
+ * @param style Pretty (indented) or compact output.
+ */
+void saveExpensesJSON(const std::vector<Expense> &expenses, const std::string &filename, JsonStyle style);
+
+/**
+ * @brief Appends expenses to an existing JSON array in place.
+ *
+ * Seeks back over the closing ']' and writes the new records plus a new ']',
+ * keeping the file's pretty or compact layout. Only the file tail is touched.
+ *
+ * @param expenses The vector of Expense objects to append.
+ * @param filename The name of the JSON file to append to.
+ * @return True if the records were appended.
+ */
+bool appendExpensesJSON(const std::vector<Expense> &expenses, const std::string &filename);
+
 /**
  * @brief Loads expenses from a JSON file with a custom filename into the provided vector.
  *
+ * The file is streamed through a SAX parser; no JSON document is built in memory.
+ *
  * @param expenses The vector to populate with loaded Expense objects.
  * @param filename The name of the file to load the expenses from.
+ * @param resource Upstream of the arena holding the loaded descriptions; it
+ *                 must outlive them.
+ */
+void loadExpensesJSON(std::vector<Expense> &expenses, const std::string &filename,
+                      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+/**
+ * @brief Saves the list of expenses to a file using the given file type.
+ *
+ * Used for machine-owned persistent files, so JSON is written compactly.
+ *
+ * @param expenses The vector of Expense objects to be saved.
+ * @param filename The name of the file to save the expenses to.
+ * @param fileType The file type ("csv", "json", "expb" or "expz").
+ */
+void saveExpenses(const std::vector<Expense> &expenses, const std::string &filename, const std::string &fileType);
+
+/**
+ * @brief Appends expenses to an existing file of the given file type without rewriting it.
+ *
+ * @param expenses The vector of Expense objects to append.
+ * @param filename The name of the file to append to.
+ * @param fileType The file type ("csv" or "json"; binary and compressed files cannot be appended to).
+ * @return True if the expenses were appended; false if the file must be rewritten instead.
+ */
+bool appendExpenses(const std::vector<Expense> &expenses, const std::string &filename, const std::string &fileType);
+
+/**
+ * @brief Loads expenses from a file of the given file type into the provided vector.
+ *
+ * @param expenses The vector to populate with loaded Expense objects.
+ * @param filename The name of the file to load the expenses from.
+ * @param fileType The file type ("csv", "json", "expb" or "expz").
+ * @param resource Upstream of the arenas holding CSV and JSON descriptions
+ *                 (binary files keep theirs in the mapping or their own arena).
+ */
+void loadExpenses(std::vector<Expense> &expenses, const std::string &filename, const std::string &fileType,
+                  std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+/**
+ * @brief Saves an expense table to a file of the given file type.
+ *
+ * @param expenses The table to save.
+ * @param filename The name of the file to save the expenses to.
+ * @param fileType The file type ("csv", "json", "expb" or "expz").
+ */
+void saveExpenses(const ExpenseTable &expenses, const std::string &filename, const std::string &fileType);
+
+/**
+ * @brief Loads expenses from a file of the given file type into an expense table.
+ *
+ * CSV and JSON descriptions are allocated from the table's memory resource.
+ *
+ * @param expenses The table to replace with the loaded expenses.
+ * @param filename The name of the file to load the expenses from.
+ * @param fileType The file type ("csv", "json", "expb" or "expz").
  */
-void loadExpensesJSON(std::vector<Expense> &expenses, const std::string &filename);
+void loadExpenses(ExpenseTable &expenses, const std::string &filename, const std::string &fileType);
 
 #endif
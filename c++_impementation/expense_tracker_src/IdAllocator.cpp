@@ -0,0 +1,30 @@
+// IdAllocator.cpp - Lock-free per-store expense ID allocation
+#include "IdAllocator.h"
+
+IdAllocator::IdAllocator(std::int64_t first) : next_(first) {}
+
+IdAllocator::IdAllocator(const IdAllocator &other) : next_(other.peek()) {}
+
+IdAllocator &IdAllocator::operator=(const IdAllocator &other) {
+    next_.store(other.peek(), std::memory_order_relaxed);
+    return *this;
+}
+
+std::int64_t IdAllocator::allocate() {
+    return next_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::int64_t IdAllocator::reserve(std::size_t count) {
+    return next_.fetch_add(static_cast<std::int64_t>(count), std::memory_order_relaxed);
+}
+
+void IdAllocator::observe(std::int64_t id) {
+    std::int64_t next = next_.load(std::memory_order_relaxed);
+    // Only ever moves forward; a failed exchange reloads next and retries
+    while (id >= next && !next_.compare_exchange_weak(next, id + 1, std::memory_order_relaxed)) {
+    }
+}
+
+std::int64_t IdAllocator::peek() const {
+    return next_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,58 @@
+#ifndef ID_ALLOCATOR_H
+#define ID_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Lock-free source of unique 64-bit expense IDs for one store.
+ *
+ * Every store owns its own allocator, so several ledgers can live in one
+ * process. allocate() and reserve() are a single atomic fetch-add and may be
+ * called from any number of threads; a batch import reserves a whole range up
+ * front and numbers its rows locally, so parallel ingest threads touch the
+ * shared counter once per batch rather than once per row.
+ */
+class IdAllocator {
+public:
+    /**
+     * @brief Create an allocator whose first ID is the given value.
+     * @param first The first ID handed out.
+     */
+    explicit IdAllocator(std::int64_t first = 1);
+
+    /**
+     * @brief Copy the position of another allocator.
+     */
+    IdAllocator(const IdAllocator &other);
+    IdAllocator &operator=(const IdAllocator &other);
+
+    /**
+     * @brief Take the next ID.
+     */
+    std::int64_t allocate();
+
+    /**
+     * @brief Take a contiguous range of IDs.
+     * @param count Number of IDs to reserve.
+     * @return The first ID of the range [first, first + count).
+     */
+    std::int64_t reserve(std::size_t count);
+
+    /**
+     * @brief Make sure an ID that is already in use (e.g. read from a file) is never handed out.
+     * @param id The ID in use.
+     */
+    void observe(std::int64_t id);
+
+    /**
+     * @brief The ID the next allocate() would return.
+     */
+    std::int64_t peek() const;
+
+private:
+    std::atomic<std::int64_t> next_;
+};
+
+#endif
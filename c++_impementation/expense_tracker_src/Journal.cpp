@@ -0,0 +1,300 @@
+// Journal.cpp - Append-only write-ahead journal for the persistent data file
+#include "Journal.h"
+#include "FileManager.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <fcntl.h>
+#include <filesystem>
+#include <memory>
+#include <unistd.h>
+#include <unordered_set>
+
+Journal::Journal(std::uintmax_t checkpointBytes, JournalSync syncMode,
+                 std::chrono::milliseconds groupWindow)
+    : size_(0), checkpointBytes_(checkpointBytes), appendOnly_(false), syncMode_(syncMode), groupWindow_(groupWindow),
+      fd_(-1), syncing_(false), stopping_(false), unsynced_(0), syncCount_(0) {}
+
+Journal::~Journal() {
+    closeFile(true);
+    {
+        std::lock_guard<std::mutex> guard(fileMutex_);
+        stopping_ = true;
+        commitWake_.notify_all();
+    }
+    if (committer_.joinable()) committer_.join();
+}
+
+std::string Journal::pathFor(const std::string &dataFile) {
+    return dataFile + ".journal";
+}
+
+/**
+ * @brief Attach to a data file; the journal file is created lazily on the first record.
+ */
+void Journal::attach(const std::string &dataFile, const std::string &fileType) {
+    detach();
+    dataFile_ = dataFile;
+    fileType_ = fileType;
+    path_ = pathFor(dataFile);
+    std::error_code ec;
+    size_ = std::filesystem::exists(path_, ec) ? std::filesystem::file_size(path_, ec) : 0;
+    if (ec) size_ = 0;
+    // Records left over from an earlier run may already be in the snapshot, so never append them
+    appendOnly_ = size_ == 0;
+}
+
+void Journal::detach() {
+    closeFile(true);
+    dataFile_.clear();
+    fileType_.clear();
+    path_.clear();
+    size_ = 0;
+    appended_.clear();
+    appendOnly_ = false;
+}
+
+bool Journal::isAttached() const {
+    return !dataFile_.empty();
+}
+
+const std::string &Journal::path() const {
+    return path_;
+}
+
+std::uintmax_t Journal::size() const {
+    return size_;
+}
+
+void Journal::setCheckpointBytes(std::uintmax_t bytes) {
+    checkpointBytes_ = bytes;
+}
+
+bool Journal::needsCheckpoint() const {
+    return isAttached() && size_ >= checkpointBytes_;
+}
+
+/**
+ * @brief Write the whole range, retrying on partial writes and interrupts.
+ */
+static bool writeAll(int fd, const char *data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Append one record line with a single write() so it survives a crash of the
+ *        process, then make it durable according to the sync mode.
+ */
+void Journal::append(const std::string &record) {
+    if (!isAttached()) return;
+    std::unique_lock<std::mutex> lk(fileMutex_);
+    if (fd_ < 0) {
+        fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd_ < 0) {
+            std::cout << "❌ Could not open journal: " << path_ << "\n";
+            return;
+        }
+    }
+    if (!writeAll(fd_, record.data(), record.size())) {
+        std::cout << "❌ Could not write journal: " << path_ << "\n";
+        return;
+    }
+    size_ += record.size();
+    switch (syncMode_) {
+        case JournalSync::None: break;
+        case JournalSync::Always:
+            ++unsynced_;
+            syncLocked(lk);
+            break;
+        case JournalSync::Group:
+            ++unsynced_;
+            if (!committer_.joinable()) committer_ = std::thread(&Journal::runCommitter, this);
+            commitWake_.notify_all();
+            break;
+    }
+}
+
+/**
+ * @brief fsync pending records, waiting for an fsync already in flight. fileMutex_ must be held.
+ */
+void Journal::syncLocked(std::unique_lock<std::mutex> &lk) {
+    commitWake_.wait(lk, [this] { return !syncing_; });
+    if (fd_ < 0 || unsynced_ == 0) return;
+    ::fsync(fd_);
+    ++syncCount_;
+    unsynced_ = 0;
+}
+
+void Journal::sync() {
+    std::unique_lock<std::mutex> lk(fileMutex_);
+    syncLocked(lk);
+}
+
+std::size_t Journal::syncCount() const {
+    std::lock_guard<std::mutex> guard(fileMutex_);
+    return syncCount_;
+}
+
+/**
+ * @brief Close the journal file descriptor, first syncing pending records if they still matter.
+ */
+void Journal::closeFile(bool syncPending) {
+    std::unique_lock<std::mutex> lk(fileMutex_);
+    if (syncPending) syncLocked(lk);
+    else commitWake_.wait(lk, [this] { return !syncing_; });
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    unsynced_ = 0;
+}
+
+/**
+ * @brief Group committer: once records are pending, wait one window so that
+ *        records written meanwhile join the batch, then cover them all with one fsync.
+ *        The fsync runs without the lock, so appends are never blocked behind it.
+ */
+void Journal::runCommitter() {
+    std::unique_lock<std::mutex> lk(fileMutex_);
+    while (!stopping_) {
+        if (unsynced_ == 0 || fd_ < 0) {
+            commitWake_.wait(lk);
+            continue;
+        }
+        commitWake_.wait_for(lk, groupWindow_, [this] { return stopping_; });
+        if (syncing_ || unsynced_ == 0 || fd_ < 0) continue;
+        int fd = fd_;
+        std::size_t batch = unsynced_;
+        syncing_ = true;
+        lk.unlock();
+        ::fsync(fd);
+        lk.lock();
+        syncing_ = false;
+        ++syncCount_;
+        unsynced_ -= std::min(batch, unsynced_);
+        commitWake_.notify_all();
+    }
+}
+
+void Journal::recordAdd(const Expense &e) {
+    char amount[Money::MAX_TEXT_SIZE];
+    char *amountEnd = e.amount.format(amount);
+    std::string record = "A," + std::to_string(e.id) + "," + e.date.toString() + ","
+                         + std::string(amount, amountEnd) + "," + e.category.name() + ","
+                         + e.description.str() + "\n";
+    append(record);
+    if (appendOnly_ && isAttached()) appended_.push_back(e);
+}
+
+void Journal::recordDelete(std::int64_t id) {
+    append("D," + std::to_string(id) + "\n");
+    appendOnly_ = false;
+    appended_.clear();
+}
+
+/**
+ * @brief Apply the records of a journal file through the given callbacks.
+ *
+ * @param path The journal file.
+ * @param ids IDs currently in the store; kept up to date while replaying.
+ * @param add Called with each expense added by the journal.
+ * @param remove Called with the ID of each expense deleted by the journal.
+ * @return Number of records that changed the store.
+ */
+template <typename Add, typename Remove>
+static std::size_t replayRecords(const std::string &path, std::unordered_set<std::int64_t> &ids, Add add, Remove remove) {
+    MappedFile file;
+    if (!file.open(path)) return 0;
+
+    std::size_t applied = 0;
+    std::string_view data = file.view();
+    auto arena = std::make_shared<StringArena>();
+    Expense e;
+    std::size_t nl;
+    // A final line without a newline is a torn record and is ignored
+    while ((nl = data.find('\n')) != std::string_view::npos) {
+        std::string_view line = data.substr(0, nl);
+        data.remove_prefix(nl + 1);
+        if (line.size() < 2 || line[1] != ',') continue;
+        std::string_view body = line.substr(2);
+        if (line[0] == 'A') {
+            if (!parseExpenseCSVRow(body, e, arena) || !ids.insert(e.id).second) continue;
+            add(e);
+            ++applied;
+        } else if (line[0] == 'D') {
+            std::int64_t id = 0;
+            auto res = std::from_chars(body.data(), body.data() + body.size(), id);
+            if (res.ec != std::errc() || ids.erase(id) == 0) continue;
+            remove(id);
+            ++applied;
+        }
+    }
+    if (applied > 0)
+        std::cout << "✅ Replayed " << applied << " journal record(s) from " << path << "\n";
+    return applied;
+}
+
+std::size_t Journal::replay(std::vector<Expense> &expenses) const {
+    if (!isAttached()) return 0;
+    std::unordered_set<std::int64_t> ids;
+    for (const auto &e : expenses) ids.insert(e.id);
+    return replayRecords(path_, ids, [&](const Expense &e) { expenses.push_back(e); }, [&](std::int64_t id) {
+        auto it = std::find_if(expenses.begin(), expenses.end(),
+                               [id](const Expense &ex) { return ex.id == id; });
+        if (it != expenses.end()) expenses.erase(it);
+    });
+}
+
+std::size_t Journal::replay(ExpenseTable &expenses) const {
+    if (!isAttached()) return 0;
+    std::unordered_set<std::int64_t> ids;
+    for (std::size_t slot = 0; slot < expenses.slots(); ++slot)
+        if (expenses.isLive(slot)) ids.insert(expenses.ids()[slot]);
+    return replayRecords(path_, ids, [&](const Expense &e) { expenses.push_back(e); },
+                         [&](std::int64_t id) { expenses.remove(id); });
+}
+
+/**
+ * @brief Fold the journal into the snapshot, then truncate the journal. Pure adds are
+ *        appended to the data file in O(added) time; anything else rewrites it.
+ */
+void Journal::checkpoint(const std::vector<Expense> &expenses) {
+    if (!isAttached()) return;
+    if (!appendOnly_ || appended_.empty() || !appendExpenses(appended_, dataFile_, fileType_))
+        saveExpenses(expenses, dataFile_, fileType_);
+    reset();
+}
+
+void Journal::checkpointIfNeeded(const std::vector<Expense> &expenses) {
+    if (needsCheckpoint()) checkpoint(expenses);
+}
+
+void Journal::checkpoint(const ExpenseTable &expenses) {
+    if (!isAttached()) return;
+    if (!appendOnly_ || appended_.empty() || !appendExpenses(appended_, dataFile_, fileType_))
+        saveExpenses(expenses, dataFile_, fileType_);
+    reset();
+}
+
+void Journal::checkpointIfNeeded(const ExpenseTable &expenses) {
+    if (needsCheckpoint()) checkpoint(expenses);
+}
+
+void Journal::reset() {
+    if (!isAttached()) return;
+    // The snapshot already holds every record, so there is nothing left to sync
+    closeFile(false);
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+    size_ = 0;
+    appended_.clear();
+    appendOnly_ = true;
+}
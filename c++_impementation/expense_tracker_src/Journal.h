@@ -0,0 +1,217 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "Expense.h"
+#include "ExpenseTable.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Journal size (in bytes) after which it is folded back into the snapshot.
+ */
+const std::uintmax_t DEFAULT_JOURNAL_CHECKPOINT_BYTES = 4 * 1024 * 1024;
+
+/**
+ * @brief How long the group committer waits for more records before issuing one fsync.
+ */
+const std::chrono::milliseconds DEFAULT_GROUP_COMMIT_WINDOW(20);
+
+/**
+ * @brief How journal records are made durable.
+ */
+enum class JournalSync {
+    None,   ///< write() only: survives a crash of the process, not of the machine
+    Always, ///< fsync after every record
+    Group   ///< a committer thread covers all records written within one window with a single fsync
+};
+
+/**
+ * @brief Append-only write-ahead journal kept next to a persistent data file.
+ *
+ * Instead of rewriting the whole snapshot (CSV, JSON, binary or compressed) after every add or delete,
+ * each mutation is appended as one line to "<dataFile>.journal". On startup the
+ * journal is replayed over the loaded snapshot, and checkpoint() folds it back
+ * into the snapshot once it grows past the configured size.
+ *
+ * Record format (one per line):
+ *   - A,<id>,<date>,<amount>,<category>,<description>
+ *   - D,<id>
+ *
+ * Replay is idempotent (adds of an existing ID and deletes of a missing ID are
+ * ignored), so a crash between writing the snapshot and truncating the journal
+ * is harmless. A torn final line without a newline is ignored.
+ * While the journal holds only adds since the snapshot was last written,
+ * checkpoint() appends those records to a CSV or JSON snapshot in place
+ * instead of rewriting it; a delete (or a binary or compressed snapshot) forces a full rewrite.
+ *
+ * In Group mode a background committer fsyncs the journal shortly after
+ * records arrive, so a burst of edits costs one fsync instead of one per record;
+ * sync() forces pending records to disk immediately.
+ * Apart from the committer, a Journal is not synchronized; AutosaveService
+ * serializes access to it.
+ */
+class Journal {
+public:
+    /**
+     * @brief Create a detached journal.
+     * @param checkpointBytes Journal size that triggers a checkpoint.
+     * @param syncMode How appended records are made durable.
+     * @param groupWindow Batching window of the group committer.
+     */
+    explicit Journal(std::uintmax_t checkpointBytes = DEFAULT_JOURNAL_CHECKPOINT_BYTES,
+                     JournalSync syncMode = JournalSync::Group,
+                     std::chrono::milliseconds groupWindow = DEFAULT_GROUP_COMMIT_WINDOW);
+
+    /**
+     * @brief Syncs pending records, closes the journal and stops the committer.
+     */
+    ~Journal();
+
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    /**
+     * @brief Attach the journal to a persistent data file, opening "<dataFile>.journal" for appending.
+     * @param dataFile The snapshot file the journal belongs to.
+     * @param fileType The snapshot file type ("csv", "json", "expb" or "expz").
+     */
+    void attach(const std::string &dataFile, const std::string &fileType);
+
+    /**
+     * @brief Close the journal file and forget the attached data file.
+     */
+    void detach();
+
+    /**
+     * @brief Whether the journal is attached to a data file.
+     */
+    bool isAttached() const;
+
+    /**
+     * @brief Path of the journal file ("<dataFile>.journal").
+     */
+    const std::string &path() const;
+
+    /**
+     * @brief Append an add record for the given expense.
+     * @param e The expense that was added.
+     */
+    void recordAdd(const Expense &e);
+
+    /**
+     * @brief Append a delete record for the given expense ID.
+     * @param id The ID of the expense that was deleted.
+     */
+    void recordDelete(std::int64_t id);
+
+    /**
+     * @brief Apply all journal records to the expenses loaded from the snapshot.
+     * @param expenses Reference to the vector of all expenses.
+     * @return Number of records that changed the expense list.
+     */
+    std::size_t replay(std::vector<Expense> &expenses) const;
+
+    /**
+     * @brief Apply all journal records to the expenses loaded from the snapshot.
+     *        Replayed adds are observed by the table's ID allocator.
+     * @param expenses Reference to the expense table.
+     * @return Number of records that changed the expense table.
+     */
+    std::size_t replay(ExpenseTable &expenses) const;
+
+    /**
+     * @brief fsync all records written so far, without waiting for the group committer.
+     */
+    void sync();
+
+    /**
+     * @brief Number of fsync calls issued on the journal so far.
+     */
+    std::size_t syncCount() const;
+
+    /**
+     * @brief Current size of the journal file in bytes.
+     */
+    std::uintmax_t size() const;
+
+    /**
+     * @brief Change the journal size that triggers a checkpoint.
+     * @param bytes New threshold in bytes.
+     */
+    void setCheckpointBytes(std::uintmax_t bytes);
+
+    /**
+     * @brief Whether the journal has grown past the checkpoint threshold.
+     */
+    bool needsCheckpoint() const;
+
+    /**
+     * @brief Bring the snapshot up to date and truncate the journal.
+     *        Appends the journaled adds when possible, otherwise rewrites the snapshot.
+     * @param expenses Const reference to the vector of all expenses.
+     */
+    void checkpoint(const std::vector<Expense> &expenses);
+
+    /**
+     * @brief Checkpoint only if the journal has grown past the threshold.
+     * @param expenses Const reference to the vector of all expenses.
+     */
+    void checkpointIfNeeded(const std::vector<Expense> &expenses);
+
+    /**
+     * @brief Bring the snapshot up to date from the expense table and truncate the journal.
+     * @param expenses Const reference to the expense table.
+     */
+    void checkpoint(const ExpenseTable &expenses);
+
+    /**
+     * @brief Checkpoint from the expense table only if the journal has grown past the threshold.
+     * @param expenses Const reference to the expense table.
+     */
+    void checkpointIfNeeded(const ExpenseTable &expenses);
+
+    /**
+     * @brief Truncate the journal, e.g. after the snapshot was rewritten in full.
+     */
+    void reset();
+
+    /**
+     * @brief Journal path used for a given data file.
+     * @param dataFile The snapshot file.
+     * @return "<dataFile>.journal"
+     */
+    static std::string pathFor(const std::string &dataFile);
+
+private:
+    void append(const std::string &record);
+    void closeFile(bool syncPending);
+    void syncLocked(std::unique_lock<std::mutex> &lk);
+    void runCommitter();
+
+    std::string dataFile_;
+    std::string fileType_;
+    std::string path_;
+    std::uintmax_t size_;
+    std::uintmax_t checkpointBytes_;
+    std::vector<Expense> appended_; // adds since the snapshot was written, while appendOnly_
+    bool appendOnly_;
+    JournalSync syncMode_;
+    std::chrono::milliseconds groupWindow_;
+
+    // Shared with the committer thread
+    mutable std::mutex fileMutex_;
+    std::condition_variable commitWake_;
+    std::thread committer_;
+    int fd_;
+    bool syncing_;
+    bool stopping_;
+    std::size_t unsynced_;
+    std::size_t syncCount_;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Lets loaders scan the file bytes in place instead of copying them through
+ * stream buffers. An empty file opens successfully with size() == 0.
+ * The mapping is released when the object is destroyed or closed.
+ */
+class MappedFile {
+public:
+    MappedFile();
+
+    /**
+     * @brief Map the given file; check isOpen() for success.
+     * @param path Path of the file to map.
+     */
+    explicit MappedFile(const std::string &path);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Map the given file, replacing any current mapping.
+     * @param path Path of the file to map.
+     * @return True if the file exists and could be mapped.
+     */
+    bool open(const std::string &path);
+
+    /**
+     * @brief Release the mapping.
+     */
+    void close();
+
+    /**
+     * @brief Whether a file is currently mapped.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Pointer to the first mapped byte (nullptr for an empty file).
+     */
+    const char *data() const;
+
+    /**
+     * @brief Size of the mapped file in bytes.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief The mapped bytes as a string view.
+     */
+    std::string_view view() const;
+
+private:
+    const char *data_;
+    std::size_t size_;
+    bool open_;
+};
+
+#endif
@@ -0,0 +1,103 @@
+// Money.cpp - Fixed-point monetary amounts in integer cents
+#include "Money.h"
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+Money::Money() : cents_(0) {}
+
+Money::Money(double amount) : cents_(0) {
+    double cents = std::round(amount * 100.0);
+    // 2^63 is exactly representable; anything at or beyond it cannot be held in cents
+    if (std::isfinite(cents) && std::fabs(cents) < 9223372036854775808.0)
+        cents_ = static_cast<std::int64_t>(cents);
+}
+
+Money Money::fromCents(std::int64_t cents) {
+    Money money;
+    money.cents_ = cents;
+    return money;
+}
+
+/**
+ * @brief Fast path reads [+-]digits[.digits] straight into cents; anything else
+ *        (exponents, huge values) goes through std::from_chars as a double.
+ */
+bool Money::parse(std::string_view text, Money &money) {
+    std::size_t i = 0, n = text.size();
+    bool negative = false;
+    if (i < n && (text[i] == '-' || text[i] == '+')) negative = text[i++] == '-';
+    std::int64_t whole = 0;
+    std::size_t digits = 0;
+    bool overflow = false;
+    for (; i < n && text[i] >= '0' && text[i] <= '9'; ++i, ++digits) {
+        if (whole > (std::numeric_limits<std::int64_t>::max() / 100 - 99) / 10) overflow = true;
+        else whole = whole * 10 + (text[i] - '0');
+    }
+    std::int64_t fraction = 0;
+    int fractionDigits = 0;
+    bool roundUp = false;
+    if (i < n && text[i] == '.') {
+        for (++i; i < n && text[i] >= '0' && text[i] <= '9'; ++i, ++digits) {
+            if (fractionDigits < 2) fraction = fraction * 10 + (text[i] - '0');
+            else if (fractionDigits == 2) roundUp = text[i] >= '5';
+            ++fractionDigits;
+        }
+    }
+    if (i == n && digits > 0 && !overflow) {
+        if (fractionDigits == 0) fraction = 0;
+        else if (fractionDigits == 1) fraction *= 10;
+        std::int64_t cents = whole * 100 + fraction + (roundUp ? 1 : 0);
+        money.cents_ = negative ? -cents : cents;
+        return true;
+    }
+
+    // std::from_chars does not take a leading '+'
+    std::string_view number = !text.empty() && text[0] == '+' ? text.substr(1) : text;
+    double value = 0;
+    auto res = std::from_chars(number.data(), number.data() + number.size(), value);
+    if (number.empty() || res.ec != std::errc() || res.ptr != number.data() + number.size() || !std::isfinite(value))
+        return false;
+    money = Money(value);
+    return true;
+}
+
+std::int64_t Money::cents() const {
+    return cents_;
+}
+
+double Money::toDouble() const {
+    return static_cast<double>(cents_) / 100.0;
+}
+
+char *Money::format(char *out) const {
+    std::uint64_t magnitude = cents_ < 0 ? 0 - static_cast<std::uint64_t>(cents_) : static_cast<std::uint64_t>(cents_);
+    if (cents_ < 0) *out++ = '-';
+    out = std::to_chars(out, out + 20, magnitude / 100).ptr;
+    unsigned fraction = static_cast<unsigned>(magnitude % 100);
+    if (fraction != 0) {
+        *out++ = '.';
+        *out++ = static_cast<char>('0' + fraction / 10);
+        if (fraction % 10 != 0) *out++ = static_cast<char>('0' + fraction % 10);
+    }
+    return out;
+}
+
+std::string Money::toString() const {
+    char buf[MAX_TEXT_SIZE];
+    return std::string(buf, format(buf));
+}
+
+std::ostream &operator<<(std::ostream &os, Money money) {
+    std::int64_t cents = money.cents();
+    std::uint64_t magnitude = cents < 0 ? 0 - static_cast<std::uint64_t>(cents) : static_cast<std::uint64_t>(cents);
+    char buf[Money::MAX_TEXT_SIZE];
+    char *p = buf;
+    if (cents < 0) *p++ = '-';
+    p = std::to_chars(p, buf + sizeof(buf), magnitude / 100).ptr;
+    *p++ = '.';
+    *p++ = static_cast<char>('0' + magnitude % 100 / 10);
+    *p++ = static_cast<char>('0' + magnitude % 10);
+    return os << std::string_view(buf, p - buf);
+}
@@ -0,0 +1,99 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Monetary amount stored as a signed 64-bit number of cents.
+ *
+ * Amounts are parsed from text straight into cents, so "0.10" is exactly ten
+ * cents, and sums are exact integer additions that give the same result in
+ * any order (and can therefore be split across threads or vector lanes).
+ * Text with more than two decimals is rounded half away from zero.
+ *
+ * Construction from double is implicit (rounding to the nearest cent) so
+ * expenses can still be written as {id, date, 12.5, category, description}.
+ */
+class Money {
+public:
+    /**
+     * @brief Buffer size that always fits the output of format().
+     */
+    static const std::size_t MAX_TEXT_SIZE = 24;
+
+    /**
+     * @brief Zero.
+     */
+    Money();
+
+    /**
+     * @brief Convert a floating-point amount, rounding to the nearest cent.
+     *        Non-finite values become zero.
+     * @param amount The amount in currency units.
+     */
+    Money(double amount);
+
+    /**
+     * @brief Create an amount from a number of cents.
+     * @param cents The amount in cents.
+     */
+    static Money fromCents(std::int64_t cents);
+
+    /**
+     * @brief Parse a decimal amount ("12", "-3.5", "0.07") directly into cents.
+     *        Exponent notation ("1.2e+06") is accepted through a floating-point fallback.
+     * @param text The amount text.
+     * @param money Receives the amount; left unchanged on failure.
+     * @return True if the whole text is a finite number.
+     */
+    static bool parse(std::string_view text, Money &money);
+
+    /**
+     * @brief The amount in cents.
+     */
+    std::int64_t cents() const;
+
+    /**
+     * @brief The amount in currency units, for display or interop only.
+     */
+    double toDouble() const;
+
+    /**
+     * @brief Format the amount in its shortest exact form ("12", "12.5", "12.34")
+     *        into a caller-provided buffer without allocating.
+     * @param out Buffer of at least MAX_TEXT_SIZE characters.
+     * @return Pointer past the last character written.
+     */
+    char *format(char *out) const;
+
+    /**
+     * @brief The shortest exact form as a string, see format().
+     */
+    std::string toString() const;
+
+    Money &operator+=(Money other) { cents_ += other.cents_; return *this; }
+    Money &operator-=(Money other) { cents_ -= other.cents_; return *this; }
+    friend Money operator+(Money a, Money b) { return a += b; }
+    friend Money operator-(Money a, Money b) { return a -= b; }
+
+    friend bool operator==(Money a, Money b) { return a.cents_ == b.cents_; }
+    friend bool operator!=(Money a, Money b) { return a.cents_ != b.cents_; }
+    friend bool operator<(Money a, Money b) { return a.cents_ < b.cents_; }
+    friend bool operator<=(Money a, Money b) { return a.cents_ <= b.cents_; }
+    friend bool operator>(Money a, Money b) { return a.cents_ > b.cents_; }
+    friend bool operator>=(Money a, Money b) { return a.cents_ >= b.cents_; }
+
+private:
+    std::int64_t cents_;
+};
+
+/**
+ * @brief Write an amount with exactly two decimals ("12.50"), honoring the stream's field width.
+ */
+std::ostream &operator<<(std::ostream &os, Money money);
+
+#endif
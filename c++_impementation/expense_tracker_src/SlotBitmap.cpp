@@ -0,0 +1,27 @@
+// SlotBitmap.cpp - Bit sets of table slots for combining index results
+#include "SlotBitmap.h"
+
+SlotBitmap::SlotBitmap(std::size_t slots) : slots_(slots), words_((slots + 63) / 64) {}
+
+SlotBitmap &SlotBitmap::operator&=(const SlotBitmap &other) {
+    for (std::size_t w = 0; w < words_.size(); ++w) words_[w] &= w < other.words_.size() ? other.words_[w] : 0;
+    return *this;
+}
+
+SlotBitmap &SlotBitmap::operator|=(const SlotBitmap &other) {
+    for (std::size_t w = 0; w < words_.size() && w < other.words_.size(); ++w) words_[w] |= other.words_[w];
+    return *this;
+}
+
+std::size_t SlotBitmap::count() const {
+    std::size_t n = 0;
+    for (std::uint64_t word : words_) n += static_cast<std::size_t>(__builtin_popcountll(word));
+    return n;
+}
+
+std::vector<std::size_t> SlotBitmap::toSlots() const {
+    std::vector<std::size_t> out;
+    out.reserve(count());
+    forEach([&out](std::size_t slot) { out.push_back(slot); });
+    return out;
+}
@@ -0,0 +1,70 @@
+#ifndef SLOT_BITMAP_H
+#define SLOT_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Fixed-size set of table slots, one bit per slot.
+ *
+ * Result sets from different indexes (a category's posting list, a date
+ * range, ...) are turned into bitmaps over the same table and combined with
+ * word-wide AND / OR, 64 slots per instruction, instead of intersecting
+ * sorted lists row by row.
+ */
+class SlotBitmap {
+public:
+    /**
+     * @brief Create an empty set over the given number of slots.
+     */
+    explicit SlotBitmap(std::size_t slots = 0);
+
+    /**
+     * @brief Number of slots the set ranges over.
+     */
+    std::size_t slots() const { return slots_; }
+
+    void set(std::size_t slot) { words_[slot / 64] |= std::uint64_t(1) << (slot % 64); }
+    void reset(std::size_t slot) { words_[slot / 64] &= ~(std::uint64_t(1) << (slot % 64)); }
+    bool test(std::size_t slot) const { return (words_[slot / 64] >> (slot % 64)) & 1; }
+
+    /**
+     * @brief Keep only the slots also in other, which must range over as many slots.
+     */
+    SlotBitmap &operator&=(const SlotBitmap &other);
+
+    /**
+     * @brief Add the slots in other, which must range over as many slots.
+     */
+    SlotBitmap &operator|=(const SlotBitmap &other);
+
+    /**
+     * @brief Number of slots in the set.
+     */
+    std::size_t count() const;
+
+    bool none() const { return count() == 0; }
+
+    /**
+     * @brief Call f(slot) for every slot in the set, in ascending order.
+     */
+    template <typename F>
+    void forEach(F f) const {
+        for (std::size_t w = 0; w < words_.size(); ++w) {
+            for (std::uint64_t bits = words_[w]; bits != 0; bits &= bits - 1)
+                f(w * 64 + static_cast<std::size_t>(__builtin_ctzll(bits)));
+        }
+    }
+
+    /**
+     * @brief The slots in the set, in ascending order.
+     */
+    std::vector<std::size_t> toSlots() const;
+
+private:
+    std::size_t slots_;
+    std::vector<std::uint64_t> words_;
+};
+
+#endif
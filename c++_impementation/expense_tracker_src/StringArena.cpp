@@ -0,0 +1,67 @@
+// StringArena.cpp - Bump allocator for bulk-loaded strings
+#include "StringArena.h"
+#include <cstring>
+#include <mutex>
+
+namespace {
+
+// Guards upstream resources that may be shared by arenas on several loader threads
+std::mutex upstreamMutex;
+
+} // namespace
+
+StringArena::StringArena(std::size_t chunkBytes, std::pmr::memory_resource *upstream)
+    : chunkBytes_(chunkBytes > 0 ? chunkBytes : DEFAULT_ARENA_CHUNK_BYTES),
+      upstream_(upstream != nullptr ? upstream : std::pmr::get_default_resource()),
+      next_(nullptr), left_(0), used_(0) {}
+
+StringArena::~StringArena() {
+    clear();
+}
+
+/**
+ * @brief Take a chunk of the given size from the upstream resource.
+ */
+char *StringArena::allocateChunk(std::size_t size) {
+    std::unique_lock<std::mutex> lock(upstreamMutex, std::defer_lock);
+    if (upstream_ != std::pmr::new_delete_resource()) lock.lock();
+    chunks_.push_back(Chunk{static_cast<char *>(upstream_->allocate(size, 1)), size});
+    return chunks_.back().data;
+}
+
+std::string_view StringArena::store(std::string_view text) {
+    if (text.empty()) return std::string_view();
+    if (text.size() > left_) {
+        // An oversized string gets its own chunk so the current one keeps its free space
+        if (text.size() > chunkBytes_ / 4) {
+            char *own = allocateChunk(text.size());
+            std::memcpy(own, text.data(), text.size());
+            used_ += text.size();
+            return std::string_view(own, text.size());
+        }
+        next_ = allocateChunk(chunkBytes_);
+        left_ = chunkBytes_;
+    }
+    char *dest = next_;
+    std::memcpy(dest, text.data(), text.size());
+    next_ += text.size();
+    left_ -= text.size();
+    used_ += text.size();
+    return std::string_view(dest, text.size());
+}
+
+void StringArena::clear() {
+    if (!chunks_.empty()) {
+        std::unique_lock<std::mutex> lock(upstreamMutex, std::defer_lock);
+        if (upstream_ != std::pmr::new_delete_resource()) lock.lock();
+        for (const Chunk &chunk : chunks_) upstream_->deallocate(chunk.data, chunk.size, 1);
+    }
+    chunks_.clear();
+    next_ = nullptr;
+    left_ = 0;
+    used_ = 0;
+}
+
+std::size_t StringArena::bytesUsed() const {
+    return used_;
+}
@@ -0,0 +1,83 @@
+#ifndef STRING_ARENA_H
+#define STRING_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Default size of each block allocated by a StringArena.
+ */
+const std::size_t DEFAULT_ARENA_CHUNK_BYTES = 64 * 1024;
+
+/**
+ * @brief Bump allocator that owns the bytes of many small strings.
+ *
+ * Strings are copied back to back into large chunks, so storing a million
+ * descriptions costs a few dozen allocations instead of a million, and
+ * releasing them all frees only the chunks. Stored strings never move and stay
+ * valid until the arena is cleared or destroyed.
+ *
+ * Chunks come from an upstream std::pmr::memory_resource (the default
+ * resource unless one is given), e.g. a monotonic_buffer_resource for a
+ * one-shot reporting job. The upstream must outlive the arena. Arenas on
+ * different threads may share an upstream that is not thread-safe: chunk
+ * allocations from any resource other than new_delete_resource() are
+ * serialized.
+ *
+ * Not thread-safe: use one arena per loader thread.
+ */
+class StringArena {
+public:
+    /**
+     * @brief Create an empty arena.
+     * @param chunkBytes Size of each chunk; longer strings get a chunk of their own.
+     */
+    explicit StringArena(std::size_t chunkBytes = DEFAULT_ARENA_CHUNK_BYTES,
+                         std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    ~StringArena();
+
+    StringArena(const StringArena &) = delete;
+    StringArena &operator=(const StringArena &) = delete;
+
+    /**
+     * @brief Copy a string into the arena.
+     * @param text The bytes to store.
+     * @return A view of the stored copy.
+     */
+    std::string_view store(std::string_view text);
+
+    /**
+     * @brief Free every chunk at once, invalidating all stored strings.
+     */
+    void clear();
+
+    /**
+     * @brief Number of string bytes stored so far.
+     */
+    std::size_t bytesUsed() const;
+
+    /**
+     * @brief The resource chunks are allocated from.
+     */
+    std::pmr::memory_resource *upstream() const { return upstream_; }
+
+private:
+    struct Chunk {
+        char *data;
+        std::size_t size;
+    };
+
+    char *allocateChunk(std::size_t size);
+
+    std::size_t chunkBytes_;
+    std::pmr::memory_resource *upstream_;
+    std::vector<Chunk> chunks_;
+    char *next_;
+    std::size_t left_;
+    std::size_t used_;
+};
+
+#endif
@@ -0,0 +1,121 @@
+// TextIndex.cpp - Inverted word index over expense descriptions
+#include "TextIndex.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+bool isWordByte(unsigned char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c >= 0x80;
+}
+
+char lower(unsigned char c) {
+    return static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+}
+
+/**
+ * @brief Call f(word) for each lower-cased word of text, in order.
+ */
+template <typename F>
+void forEachWord(std::string_view text, F f) {
+    std::pmr::string word; // reused, so looking a word up allocates nothing
+    for (std::size_t i = 0; i <= text.size(); ++i) {
+        if (i < text.size() && isWordByte(static_cast<unsigned char>(text[i]))) {
+            word += lower(static_cast<unsigned char>(text[i]));
+        } else if (!word.empty()) {
+            f(word);
+            word.clear();
+        }
+    }
+}
+
+} // namespace
+
+TextIndex::TextIndex(std::pmr::memory_resource *resource) : postings_(resource) {}
+
+void TextIndex::add(std::size_t slot, std::string_view text) {
+    std::uint32_t position = 0;
+    forEachWord(text, [&](const std::pmr::string &word) {
+        auto it = postings_.find(word);
+        if (it == postings_.end()) it = postings_.emplace(word, PostingList()).first;
+        it->second.push_back(Posting{slot, position++});
+    });
+}
+
+/**
+ * @brief The distinct slots of a posting list, which is sorted by slot.
+ */
+std::vector<std::size_t> TextIndex::slotsOf(const PostingList &list) {
+    std::vector<std::size_t> out;
+    for (const Posting &p : list)
+        if (out.empty() || out.back() != p.slot) out.push_back(p.slot);
+    return out;
+}
+
+std::vector<std::size_t> TextIndex::term(std::string_view word) const {
+    std::vector<std::string> words = tokenize(word);
+    if (words.size() != 1) return {};
+    auto it = postings_.find(std::pmr::string(words[0]));
+    return it == postings_.end() ? std::vector<std::size_t>() : slotsOf(it->second);
+}
+
+std::vector<std::size_t> TextIndex::prefix(std::string_view prefix) const {
+    std::vector<std::string> words = tokenize(prefix);
+    if (words.size() != 1) return {};
+    std::string_view start = words[0];
+    std::vector<std::size_t> out;
+    for (const auto &entry : postings_) {
+        if (std::string_view(entry.first).substr(0, start.size()) != start) continue;
+        std::vector<std::size_t> slots = slotsOf(entry.second);
+        out.insert(out.end(), slots.begin(), slots.end());
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+std::vector<std::size_t> TextIndex::phrase(std::string_view phrase) const {
+    std::vector<std::string> words = tokenize(phrase);
+    if (words.empty()) return {};
+    std::vector<const PostingList *> lists;
+    for (const std::string &word : words) {
+        auto it = postings_.find(std::pmr::string(word));
+        if (it == postings_.end()) return {};
+        lists.push_back(&it->second);
+    }
+    auto before = [](const Posting &a, const Posting &b) {
+        return a.slot != b.slot ? a.slot < b.slot : a.position < b.position;
+    };
+    std::vector<std::size_t> out;
+    for (const Posting &first : *lists[0]) {
+        if (!out.empty() && out.back() == first.slot) continue;
+        bool match = true;
+        for (std::size_t k = 1; k < lists.size() && match; ++k) {
+            Posting next{first.slot, first.position + static_cast<std::uint32_t>(k)};
+            match = std::binary_search(lists[k]->begin(), lists[k]->end(), next, before);
+        }
+        if (match) out.push_back(first.slot);
+    }
+    return out;
+}
+
+void TextIndex::remap(const std::vector<std::size_t> &newSlot) {
+    for (auto it = postings_.begin(); it != postings_.end();) {
+        PostingList &list = it->second;
+        std::size_t kept = 0;
+        for (const Posting &p : list)
+            if (newSlot[p.slot] != static_cast<std::size_t>(-1)) list[kept++] = Posting{newSlot[p.slot], p.position};
+        list.resize(kept);
+        it = list.empty() ? postings_.erase(it) : std::next(it);
+    }
+}
+
+void TextIndex::clear() {
+    postings_.clear();
+}
+
+std::vector<std::string> TextIndex::tokenize(std::string_view text) {
+    std::vector<std::string> words;
+    forEachWord(text, [&words](const std::pmr::string &word) { words.emplace_back(word); });
+    return words;
+}
@@ -0,0 +1,90 @@
+#ifndef TEXT_INDEX_H
+#define TEXT_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Inverted index from description words to the table slots that contain them.
+ *
+ * Text is split into words at every character that is not an ASCII letter or
+ * digit (bytes of multi-byte UTF-8 characters count as letters) and ASCII is
+ * folded to lower case, so "Uber", "UBER" and "uber," are the same word.
+ * Each word keeps a posting list of (slot, position) pairs in ascending order:
+ *
+ * - term(): one hash lookup, then the posting list of the word;
+ * - prefix(): a pass over the dictionary (distinct words, not rows), merging
+ *   the lists of the words that match;
+ * - phrase(): the first word's postings, checked for the following words at
+ *   the following positions by binary search.
+ *
+ * Slots are expected to be added in ascending order, as a table appends rows.
+ * Like the table's other indexes, removed rows are not taken out: callers
+ * skip dead slots, and remap() renumbers the postings after compaction.
+ */
+class TextIndex {
+public:
+    /**
+     * @brief Create an empty index that allocates from the given resource.
+     */
+    explicit TextIndex(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Index the words of a slot's text; slot must not be below any slot added before.
+     */
+    void add(std::size_t slot, std::string_view text);
+
+    /**
+     * @brief Slots containing the word, ascending and without duplicates.
+     */
+    std::vector<std::size_t> term(std::string_view word) const;
+
+    /**
+     * @brief Slots containing a word that starts with the given prefix, ascending and without duplicates.
+     */
+    std::vector<std::size_t> prefix(std::string_view prefix) const;
+
+    /**
+     * @brief Slots containing the words of the phrase next to each other, in order.
+     */
+    std::vector<std::size_t> phrase(std::string_view phrase) const;
+
+    /**
+     * @brief Renumber the postings after compaction.
+     * @param newSlot New slot of each old slot, or npos for a removed row.
+     */
+    void remap(const std::vector<std::size_t> &newSlot);
+
+    /**
+     * @brief Remove every word.
+     */
+    void clear();
+
+    /**
+     * @brief Number of distinct words.
+     */
+    std::size_t words() const { return postings_.size(); }
+
+    /**
+     * @brief Split text into lower-case words, in order.
+     */
+    static std::vector<std::string> tokenize(std::string_view text);
+
+private:
+    struct Posting {
+        std::size_t slot;
+        std::uint32_t position;
+    };
+    using PostingList = std::pmr::vector<Posting>;
+
+    static std::vector<std::size_t> slotsOf(const PostingList &list);
+
+    std::pmr::unordered_map<std::pmr::string, PostingList> postings_;
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include "Utils.h"
 #include "FileManager.h"
+#include "BinaryStore.h"
+#include "BlockStore.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -7,6 +9,7 @@
 #include <algorithm>
 #include <limits>
 #include <cmath>
+#include <cstdio>
 #include "Expense.h"
 
 /**
@@ -32,16 +35,9 @@ void displayCategories() {
  * @return The category name as a string, or an empty string if the number is invalid.
  */
 std::string getCategoryByNumber(int num) {
-    switch (num) {
-        case 1: return "Housing";
-        case 2: return "Transportation";
-        case 3: return "Food & Dining";
-        case 4: return "Utilities & Communication";
-        case 5: return "Healthcare & Insurance";
-        case 6: return "Personal & Debt";
-        case 7: return "Other";
-        default: return "";
-    }
+    // The built-in categories are registered under their menu numbers
+    if (num < 1 || num >= static_cast<int>(Category::BUILTIN_COUNT)) return "";
+    return Category::fromId(static_cast<std::uint16_t>(num)).name();
 }
 
 /**
@@ -54,9 +50,36 @@ time_t parseDate(const std::string &dateStr) {
     tm t = {};
     std::istringstream ss(dateStr);
     ss >> std::get_time(&t, "%Y-%m-%d");
+    if (ss.fail()) return -1;
     return mktime(&t);
 }
 
+/**
+ * @brief Converts a date string in YYYY-MM-DD format to a day number.
+ *        Uses the proleptic Gregorian calendar (days-from-civil).
+ *
+ * @param dateStr The date string in "YYYY-MM-DD" format.
+ * @param days Receives the number of days since 1970-01-01.
+ * @return True if the date is valid, false otherwise.
+ */
+bool dateToDays(const std::string &dateStr, int &days) {
+    Date date;
+    if (!Date::parse(dateStr, date)) return false;
+    days = date.days();
+    return true;
+}
+
+/**
+ * @brief Converts a day number back to a date string in YYYY-MM-DD format.
+ *        Uses the proleptic Gregorian calendar (civil-from-days).
+ *
+ * @param days The number of days since 1970-01-01.
+ * @return The date string.
+ */
+std::string daysToDate(int days) {
+    return Date::fromDays(days).toString();
+}
+
 /**
  * @brief Displays the main menu for the expense tracker CLI application.
  *
@@ -70,8 +93,8 @@ void displayMenu() {
     std::cout << "4. Filter by Category\n";
     std::cout << "5. Filter by Date Range\n";
     std::cout << "6. Summary Report\n";
-    std::cout << "7. Save Expenses (CSV/JSON)\n";
-    std::cout << "8. Load Expenses (CSV/JSON)\n";
+    std::cout << "7. Save Expenses (CSV/JSON/Binary/Compressed)\n";
+    std::cout << "8. Load Expenses (CSV/JSON/Binary/Compressed)\n";
     std::cout << "9. Exit\n";
 }
 
@@ -97,20 +120,8 @@ bool isValidAmount(const std::string &amountStr) {
  * @return True if valid, false otherwise.
  */
 bool isValidDate(const std::string &dateStr) {
-    if (dateStr.size() != 10) return false;
-    if (dateStr[4] != '-' || dateStr[7] != '-') return false;
-    int y, m, d;
-    try {
-        y = std::stoi(dateStr.substr(0,4));
-        m = std::stoi(dateStr.substr(5,2));
-        d = std::stoi(dateStr.substr(8,2));
-    } catch (...) { return false; }
-    if (y < 1900 || m < 1 || m > 12 || d < 1 || d > 31) return false;
-    // Simple check for days in month
-    static const int days_in_month[] = {31,28,31,30,31,30,31,31,30,31,30,31};
-    int maxd = days_in_month[m-1];
-    if (m == 2 && ((y%4==0 && y%100!=0) || (y%400==0))) maxd = 29;
-    return d <= maxd;
+    Date date;
+    return Date::parse(dateStr, date);
 }
 
 /**
@@ -135,7 +146,7 @@ bool isValidCategory(const std::string &category) {
  * @return True if valid, false otherwise.
  */
 bool isValidDescription(const std::string &desc) {
-    return !desc.empty() && desc.size() <= 200;
+    return !desc.empty() && desc.size() <= MAX_DESCRIPTION_LENGTH;
 }
 
 /**
@@ -147,7 +158,10 @@ bool isValidDescription(const std::string &desc) {
  */
 std::vector<Expense> filterByCategory(const std::vector<Expense> &expenses, const std::string &category) {
     std::vector<Expense> out;
-    for (const auto &e : expenses) if (e.category == category) out.push_back(e);
+    // Resolve the name once; each row is then an integer compare
+    Category wanted;
+    if (!Category::find(category, wanted)) return out;
+    for (const auto &e : expenses) if (e.category == wanted) out.push_back(e);
     return out;
 }
 
@@ -160,7 +174,9 @@ std::vector<Expense> filterByCategory(const std::vector<Expense> &expenses, cons
  */
 std::vector<Expense> filterByDate(const std::vector<Expense> &expenses, const std::string &dateStr) {
     std::vector<Expense> out;
-    for (const auto &e : expenses) if (e.date == dateStr) out.push_back(e);
+    Date date(dateStr);
+    if (!date.isValid()) return out;
+    for (const auto &e : expenses) if (e.date == date) out.push_back(e);
     return out;
 }
 
@@ -168,12 +184,23 @@ std::vector<Expense> filterByDate(const std::vector<Expense> &expenses, const st
  * @brief Calculates the total amount of all expenses.
  *
  * @param expenses The list of expenses.
- * @return The sum of all expense amounts.
+ * @return The exact sum of all expense amounts.
+ */
+Money getTotalExpenses(const std::vector<Expense> &expenses) {
+    // Integer addition is associative, so the compiler is free to reorder and vectorize this loop
+    std::int64_t cents = 0;
+    for (const auto &e : expenses) cents += e.amount.cents();
+    return Money::fromCents(cents);
+}
+
+/**
+ * @brief Turn per-category totals, indexed by category ID, into a map keyed by name.
  */
-double getTotalExpenses(const std::vector<Expense> &expenses) {
-    double sum = 0.0;
-    for (const auto &e : expenses) sum += e.amount;
-    return sum;
+static std::map<std::string, Money> categoryTotals(const std::vector<Money> &byId, const std::vector<bool> &used) {
+    std::map<std::string, Money> totals;
+    for (std::size_t id = 0; id < byId.size(); ++id)
+        if (used[id]) totals[Category::fromId(static_cast<std::uint16_t>(id)).name()] = byId[id];
+    return totals;
 }
 
 /**
@@ -182,22 +209,165 @@ double getTotalExpenses(const std::vector<Expense> &expenses) {
  * @param expenses The list of expenses.
  * @return A map from category name to total amount spent in that category.
  */
-std::map<std::string, double> getCategoryTotals(const std::vector<Expense> &expenses) {
-    std::map<std::string, double> totals;
-    for (const auto &e : expenses) totals[e.category] += e.amount;
-    return totals;
+std::map<std::string, Money> getCategoryTotals(const std::vector<Expense> &expenses) {
+    std::vector<Money> byId(Category::count());
+    std::vector<bool> used(byId.size());
+    for (const auto &e : expenses) {
+        byId[e.category.id()] += e.amount;
+        used[e.category.id()] = true;
+    }
+    return categoryTotals(byId, used);
+}
+
+/**
+ * @brief Filters an expense table by category, reading only the category's posting list.
+ *
+ * @param expenses The expense table.
+ * @param category The category to filter by.
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView filterByCategory(const ExpenseTable &expenses, const std::string &category,
+                             std::pmr::memory_resource *resource) {
+    ExpenseView out(expenses, resource);
+    Category wanted;
+    if (!Category::find(category, wanted)) return out;
+    for (std::size_t slot : expenses.slotsIn(wanted))
+        if (expenses.isLive(slot)) out.push_back(slot);
+    return out;
+}
+
+/**
+ * @brief Filters an expense table by date, looking the date up in the table's date index.
+ *
+ * @param expenses The expense table.
+ * @param dateStr The date to filter by (YYYY-MM-DD).
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView filterByDate(const ExpenseTable &expenses, const std::string &dateStr,
+                         std::pmr::memory_resource *resource) {
+    Date date(dateStr);
+    if (!date.isValid()) return ExpenseView(expenses, resource);
+    // Equal dates are kept in slot order in the index
+    return filterByDateRange(expenses, date, date, resource);
+}
+
+/**
+ * @brief Filters an expense table by an inclusive date range using the table's date index.
+ *
+ * @param expenses The expense table.
+ * @param first The earliest date wanted.
+ * @param last The latest date wanted.
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in date order.
+ */
+ExpenseView filterByDateRange(const ExpenseTable &expenses, Date first, Date last,
+                              std::pmr::memory_resource *resource) {
+    ExpenseView out(expenses, resource);
+    const std::pmr::vector<std::size_t> &byDate = expenses.byDate();
+    auto range = expenses.dateRange(first, last);
+    for (std::size_t pos = range.first; pos < range.second; ++pos)
+        if (expenses.isLive(byDate[pos])) out.push_back(byDate[pos]);
+    return out;
+}
+
+/**
+ * @brief Build a view of the live slots in a list of slots from one of the table's indexes.
+ */
+static ExpenseView liveView(const ExpenseTable &expenses, const std::vector<std::size_t> &slots,
+                            std::pmr::memory_resource *resource) {
+    ExpenseView out(expenses, resource);
+    for (std::size_t slot : slots)
+        if (expenses.isLive(slot)) out.push_back(slot);
+    return out;
+}
+
+/**
+ * @brief Finds the rows whose description contains a word, using the table's word index.
+ *
+ * @param expenses The expense table.
+ * @param word The word to look for (case-insensitive).
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView searchByTerm(const ExpenseTable &expenses, const std::string &word,
+                         std::pmr::memory_resource *resource) {
+    return liveView(expenses, expenses.textIndex().term(word), resource);
+}
+
+/**
+ * @brief Finds the rows whose description has a word starting with the given prefix.
+ *
+ * @param expenses The expense table.
+ * @param prefix The start of a word (case-insensitive).
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView searchByPrefix(const ExpenseTable &expenses, const std::string &prefix,
+                           std::pmr::memory_resource *resource) {
+    return liveView(expenses, expenses.textIndex().prefix(prefix), resource);
+}
+
+/**
+ * @brief Finds the rows whose description contains the words of a phrase next to each other, in order.
+ *
+ * @param expenses The expense table.
+ * @param phrase The words to look for (case-insensitive).
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView searchByPhrase(const ExpenseTable &expenses, const std::string &phrase,
+                           std::pmr::memory_resource *resource) {
+    return liveView(expenses, expenses.textIndex().phrase(phrase), resource);
+}
+
+/**
+ * @brief Calculates the total amount of an expense table from its amount column.
+ *
+ * @param expenses The expense table.
+ * @return The exact sum of all expense amounts.
+ */
+Money getTotalExpenses(const ExpenseTable &expenses) {
+    // Dense columns of int64 cents and 0/1 live flags: a branch-free, vectorizable sum
+    const std::pmr::vector<Money> &amounts = expenses.amounts();
+    const std::pmr::vector<std::uint8_t> &live = expenses.live();
+    std::int64_t cents = 0;
+    for (std::size_t i = 0; i < amounts.size(); ++i) cents += amounts[i].cents() * live[i];
+    return Money::fromCents(cents);
+}
+
+/**
+ * @brief Calculates the total amount spent per category from the category and amount columns.
+ *
+ * @param expenses The expense table.
+ * @return A map from category name to total amount spent in that category.
+ */
+std::map<std::string, Money> getCategoryTotals(const ExpenseTable &expenses) {
+    const std::pmr::vector<Category> &categories = expenses.categories();
+    const std::pmr::vector<Money> &amounts = expenses.amounts();
+    std::vector<Money> byId(Category::count());
+    std::vector<bool> used(byId.size());
+    for (std::size_t i = 0; i < categories.size(); ++i) {
+        if (!expenses.isLive(i)) continue;
+        byId[categories[i].id()] += amounts[i];
+        used[categories[i].id()] = true;
+    }
+    return categoryTotals(byId, used);
 }
 
 /**
  * @brief Prompt user to choose file type and filename for saving expenses.
- *        Supports CSV and JSON. Persistent file is separate from preload files.
+ *        Supports CSV, JSON, binary (.expb) and compressed (.expz). Persistent file is separate from preload files.
  */
-void saveExpensesMenu(const std::vector<Expense> &expenses, std::string &currentDataFile, std::string &currentFileType) {
-    std::cout << "Save as: 1) CSV  2) JSON\nChoice: ";
+bool saveExpensesMenu(const ExpenseTable &table, std::string &currentDataFile, std::string &currentFileType) {
+    std::cout << "Save as: 1) CSV  2) JSON  3) Binary  4) Compressed\nChoice: ";
     int type; std::string typeInput;
     std::getline(std::cin, typeInput);
     std::stringstream ss(typeInput);
     ss >> type;
+    // The writers work on rows; descriptions are shared, not copied
+    std::vector<Expense> expenses = type >= 1 && type <= 4 ? table.toVector() : std::vector<Expense>();
     std::string filename;
     if (type == 1) {
         std::cout << "Enter filename (default: expenses_persistent.csv): ";
@@ -206,6 +376,7 @@ void saveExpensesMenu(const std::vector<Expense> &expenses, std::string &current
         saveExpensesCSV(expenses, filename);
         currentDataFile = filename;
         currentFileType = "csv";
+        return true;
     } else if (type == 2) {
         std::cout << "Enter filename (default: expenses_persistent.json): ";
         std::getline(std::cin, filename);
@@ -213,17 +384,34 @@ void saveExpensesMenu(const std::vector<Expense> &expenses, std::string &current
         saveExpensesJSON(expenses, filename);
         currentDataFile = filename;
         currentFileType = "json";
-    } else {
-        std::cout << "Invalid choice.\n";
+        return true;
+    } else if (type == 3) {
+        std::cout << "Enter filename (default: expenses_persistent.expb): ";
+        std::getline(std::cin, filename);
+        if (filename.empty()) filename = "expenses_persistent.expb";
+        saveExpensesBinary(expenses, filename);
+        currentDataFile = filename;
+        currentFileType = "expb";
+        return true;
+    } else if (type == 4) {
+        std::cout << "Enter filename (default: expenses_persistent.expz): ";
+        std::getline(std::cin, filename);
+        if (filename.empty()) filename = "expenses_persistent.expz";
+        saveExpensesBlocks(expenses, filename);
+        currentDataFile = filename;
+        currentFileType = "expz";
+        return true;
     }
+    std::cout << "Invalid choice.\n";
+    return false;
 }
 
 /**
  * @brief Prompt user to choose file type and filename for loading expenses.
- *        Supports CSV and JSON. Persistent file is separate from preload files.
+ *        Supports CSV, JSON, binary (.expb) and compressed (.expz). Persistent file is separate from preload files.
  */
-void loadExpensesMenu(std::vector<Expense> &expenses, std::string &currentDataFile, std::string &currentFileType) {
-    std::cout << "Load from: 1) CSV  2) JSON\nChoice: ";
+bool loadExpensesMenu(ExpenseTable &expenses, std::string &currentDataFile, std::string &currentFileType) {
+    std::cout << "Load from: 1) CSV  2) JSON  3) Binary  4) Compressed\nChoice: ";
     int type; std::string typeInput;
     std::getline(std::cin, typeInput);
     std::stringstream ss(typeInput);
@@ -233,17 +421,35 @@ void loadExpensesMenu(std::vector<Expense> &expenses, std::string &currentDataFi
         std::cout << "Enter filename (default: expenses_persistent.csv): ";
         std::getline(std::cin, filename);
         if (filename.empty()) filename = "expenses_persistent.csv";
-        loadExpensesCSV(expenses, filename);
+        loadExpenses(expenses, filename, "csv");
         currentDataFile = filename;
         currentFileType = "csv";
+        return true;
     } else if (type == 2) {
         std::cout << "Enter filename (default: expenses_persistent.json): ";
         std::getline(std::cin, filename);
         if (filename.empty()) filename = "expenses_persistent.json";
-        loadExpensesJSON(expenses, filename);
+        loadExpenses(expenses, filename, "json");
         currentDataFile = filename;
         currentFileType = "json";
-    } else {
-        std::cout << "Invalid choice.\n";
+        return true;
+    } else if (type == 3) {
+        std::cout << "Enter filename (default: expenses_persistent.expb): ";
+        std::getline(std::cin, filename);
+        if (filename.empty()) filename = "expenses_persistent.expb";
+        loadExpenses(expenses, filename, "expb");
+        currentDataFile = filename;
+        currentFileType = "expb";
+        return true;
+    } else if (type == 4) {
+        std::cout << "Enter filename (default: expenses_persistent.expz): ";
+        std::getline(std::cin, filename);
+        if (filename.empty()) filename = "expenses_persistent.expz";
+        loadExpenses(expenses, filename, "expz");
+        currentDataFile = filename;
+        currentFileType = "expz";
+        return true;
     }
+    std::cout << "Invalid choice.\n";
+    return false;
 }
@@ -5,7 +5,10 @@
 #include <ctime>
 #include <vector>
 #include <map>
+#include <memory_resource>
 #include "Expense.h"
+#include "ExpenseTable.h"
+#include "ExpenseView.h"
 
 /**
  * @brief Displays the list of available expense categories with their corresponding numbers.
@@ -30,6 +33,23 @@ std::string getCategoryByNumber(int num);
  */
 time_t parseDate(const std::string &dateStr);
 
+/**
+ * @brief Converts a date string in YYYY-MM-DD format to a day number.
+ *
+ * @param dateStr The date string in "YYYY-MM-DD" format.
+ * @param days Receives the number of days since 1970-01-01.
+ * @return True if the date is valid, false otherwise.
+ */
+bool dateToDays(const std::string &dateStr, int &days);
+
+/**
+ * @brief Converts a day number back to a date string in YYYY-MM-DD format.
+ *
+ * @param days The number of days since 1970-01-01.
+ * @return The date string.
+ */
+std::string daysToDate(int days);
+
 /**
  * @brief Displays the main menu for the expense tracker CLI application.
  *
@@ -91,9 +111,9 @@ std::vector<Expense> filterByDate(const std::vector<Expense> &expenses, const st
  * @brief Calculates the total amount of all expenses.
  *
  * @param expenses The list of expenses.
- * @return The sum of all expense amounts.
+ * @return The exact sum of all expense amounts.
  */
-double getTotalExpenses(const std::vector<Expense> &expenses);
+Money getTotalExpenses(const std::vector<Expense> &expenses);
 
 /**
  * @brief Calculates the total amount spent per category.
@@ -101,7 +121,92 @@ double getTotalExpenses(const std::vector<Expense> &expenses);
  * @param expenses The list of expenses.
  * @return A map from category name to total amount spent in that category.
  */
-std::map<std::string, double> getCategoryTotals(const std::vector<Expense> &expenses);
+std::map<std::string, Money> getCategoryTotals(const std::vector<Expense> &expenses);
+
+/**
+ * @brief Filters an expense table by category, reading only the category's posting list.
+ *
+ * @param expenses The expense table.
+ * @param category The category to filter by.
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView filterByCategory(const ExpenseTable &expenses, const std::string &category,
+                             std::pmr::memory_resource *resource = nullptr);
+
+/**
+ * @brief Filters an expense table by date, looking the date up in the table's date index.
+ *
+ * @param expenses The expense table.
+ * @param dateStr The date to filter by (YYYY-MM-DD).
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView filterByDate(const ExpenseTable &expenses, const std::string &dateStr,
+                         std::pmr::memory_resource *resource = nullptr);
+
+/**
+ * @brief Filters an expense table by an inclusive date range using the table's date index.
+ *
+ * @param expenses The expense table.
+ * @param first The earliest date wanted.
+ * @param last The latest date wanted.
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in date order.
+ */
+ExpenseView filterByDateRange(const ExpenseTable &expenses, Date first, Date last,
+                              std::pmr::memory_resource *resource = nullptr);
+
+/**
+ * @brief Finds the rows whose description contains a word, using the table's word index.
+ *
+ * Matching ignores ASCII case and punctuation: "uber" finds "Uber ride" and "UBER,".
+ *
+ * @param expenses The expense table.
+ * @param word The word to look for.
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView searchByTerm(const ExpenseTable &expenses, const std::string &word,
+                         std::pmr::memory_resource *resource = nullptr);
+
+/**
+ * @brief Finds the rows whose description has a word starting with the given prefix.
+ *
+ * @param expenses The expense table.
+ * @param prefix The start of a word, e.g. "groc" for "Groceries".
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView searchByPrefix(const ExpenseTable &expenses, const std::string &prefix,
+                           std::pmr::memory_resource *resource = nullptr);
+
+/**
+ * @brief Finds the rows whose description contains the words of a phrase next to each other, in order.
+ *
+ * @param expenses The expense table.
+ * @param phrase The words to look for, e.g. "uber eats".
+ * @param resource Source of the result's memory; null uses the table's resource.
+ * @return A view of the matching rows, in table order.
+ */
+ExpenseView searchByPhrase(const ExpenseTable &expenses, const std::string &phrase,
+                           std::pmr::memory_resource *resource = nullptr);
+
+/**
+ * @brief Calculates the total amount of an expense table from its amount column.
+ *
+ * @param expenses The expense table.
+ * @return The exact sum of all expense amounts.
+ */
+Money getTotalExpenses(const ExpenseTable &expenses);
+
+/**
+ * @brief Calculates the total amount spent per category from the category and amount columns.
+ *
+ * @param expenses The expense table.
+ * @return A map from category name to total amount spent in that category.
+ */
+std::map<std::string, Money> getCategoryTotals(const ExpenseTable &expenses);
 
 /**
  * @brief Saves the list of expenses to a file.
@@ -109,8 +214,9 @@ std::map<std::string, double> getCategoryTotals(const std::vector<Expense> &expe
  * @param expenses The list of expenses to save.
  * @param currentDataFile The current data file being used.
  * @param currentFileType The current file type being used.
+ * @return True if the expenses were saved.
  */
-void saveExpensesMenu(const std::vector<Expense> &expenses, std::string &currentDataFile, std::string &currentFileType);
+bool saveExpensesMenu(const ExpenseTable &expenses, std::string &currentDataFile, std::string &currentFileType);
 
 /**
  * @brief Loads the list of expenses from a file.
@@ -118,8 +224,9 @@ void saveExpensesMenu(const std::vector<Expense> &expenses, std::string &current
  * @param expenses The list of expenses to load into.
  * @param currentDataFile The current data file being used.
  * @param currentFileType The current file type being used.
+ * @return True if the expenses were loaded.
  */
-void loadExpensesMenu(std::vector<Expense> &expenses, std::string &currentDataFile, std::string &currentFileType);
+bool loadExpensesMenu(ExpenseTable &expenses, std::string &currentDataFile, std::string &currentFileType);
 
 /**
  * @brief Displays the list of expenses.
@@ -127,6 +234,6 @@ void loadExpensesMenu(std::vector<Expense> &expenses, std::string &currentDataFi
  * @param expenses The list of expenses to display.
  * @param currentDataFile The current data file being used.
  */
-void viewExpenses(const std::vector<Expense> &expenses, const std::string &currentDataFile);
+void viewExpenses(const ExpenseTable &expenses, const std::string &currentDataFile);
 
 #endif
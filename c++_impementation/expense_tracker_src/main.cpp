@@ -1,10 +1,14 @@
 #include "Expense.h"
+#include "ExpenseTable.h"
 #include "FileManager.h"
+#include "Autosave.h"
+#include "Journal.h"
 #include "Utils.h"
 #include <vector>
 #include <iostream>
 #include <sstream>
 #include <filesystem>
+#include <utility>
 
 /**
  * @brief Entry point for the Expense Tracker CLI application.
@@ -12,25 +16,38 @@
  * Initializes the main expense list and handles the main menu loop.
  * Presents the user with all available options and dispatches to the appropriate
  * function for each menu choice. Handles input validation for menu selection.
+ * Adds and deletes are appended to the journal of the current data file instead
+ * of rewriting the whole file; a background autosave thread folds the journal
+ * back into the data file once edits settle, and a final flush runs on exit.
  *
  * @return int Exit status code (0 for success).
  */
 int main() {
-    std::vector<Expense> expenses;
+    ExpenseTable expenses;
     std::string currentDataFile = "";
-    std::string currentFileType = ""; // "csv" or "json"
+    std::string currentFileType = ""; // "csv", "json", "expb" or "expz"
+    Journal journal;
     int choice;
 
-    // Auto-load persistent file if it exists
-    if (std::filesystem::exists("expenses_persistent.csv")) {
-        loadExpensesCSV(expenses, "expenses_persistent.csv");
-        currentDataFile = "expenses_persistent.csv";
-        currentFileType = "csv";
-    } else if (std::filesystem::exists("expenses_persistent.json")) {
-        loadExpensesJSON(expenses, "expenses_persistent.json");
-        currentDataFile = "expenses_persistent.json";
-        currentFileType = "json";
+    // Auto-load the persistent file if it exists; the binary snapshot loads fastest
+    const std::pair<const char *, const char *> persistentFiles[] = {
+        {"expenses_persistent.expb", "expb"},
+        {"expenses_persistent.expz", "expz"},
+        {"expenses_persistent.csv", "csv"},
+        {"expenses_persistent.json", "json"}
+    };
+    for (const auto &candidate : persistentFiles) {
+        if (!std::filesystem::exists(candidate.first)) continue;
+        currentDataFile = candidate.first;
+        currentFileType = candidate.second;
+        loadExpenses(expenses, currentDataFile, currentFileType);
+        journal.attach(currentDataFile, currentFileType);
+        journal.replay(expenses);
+        break;
     }
+    AutosaveService autosave(expenses, journal);
+    if (journal.size() > 0) autosave.markDirty();
+    autosave.start();
 
     std::cout << "\n=====================================\n";
     std::cout << "         Expense Tracker CLI          \n";
@@ -44,32 +61,43 @@ int main() {
         std::stringstream ss(choiceInput);
         ss >> choice;
 
+        // Keep the background autosave away from the store while a command runs
+        auto storeLock = autosave.lock();
         switch (choice) {
             case 1:
                 addExpense(expenses);
-                if (!currentDataFile.empty() && !currentFileType.empty()) {
-                    if (currentFileType == "csv") saveExpensesCSV(expenses, currentDataFile);
-                    else if (currentFileType == "json") saveExpensesJSON(expenses, currentDataFile);
-                }
+                if (journal.isAttached()) journal.recordAdd(expenses.back());
+                autosave.markDirty();
                 break;
             case 2: viewExpenses(expenses, currentDataFile.empty() ? "(unsaved/manual entry)" : currentDataFile); break;
-            case 3:
-                deleteExpense(expenses);
-                if (!currentDataFile.empty() && !currentFileType.empty()) {
-                    if (currentFileType == "csv") saveExpensesCSV(expenses, currentDataFile);
-                    else if (currentFileType == "json") saveExpensesJSON(expenses, currentDataFile);
+            case 3: {
+                std::int64_t deletedID = deleteExpense(expenses);
+                if (deletedID != 0) {
+                    if (journal.isAttached()) journal.recordDelete(deletedID);
+                    autosave.markDirty();
                 }
                 break;
+            }
             case 4: filterByCategory(expenses); break;
             case 5: filterByDateRange(expenses); break;
             case 6: summaryReport(expenses); break;
-            case 7: saveExpensesMenu(expenses, currentDataFile, currentFileType); break;
-            case 8: loadExpensesMenu(expenses, currentDataFile, currentFileType); break;
-            case 9:
-                if (!currentDataFile.empty() && !currentFileType.empty()) {
-                    if (currentFileType == "csv") saveExpensesCSV(expenses, currentDataFile);
-                    else if (currentFileType == "json") saveExpensesJSON(expenses, currentDataFile);
+            case 7:
+                // A full save makes the snapshot current, so its journal is no longer needed
+                if (saveExpensesMenu(expenses, currentDataFile, currentFileType)) {
+                    journal.attach(currentDataFile, currentFileType);
+                    journal.reset();
+                    expenses.compact(); // the saved file has no tombstones either
+                }
+                break;
+            case 8:
+                if (loadExpensesMenu(expenses, currentDataFile, currentFileType)) {
+                    journal.attach(currentDataFile, currentFileType);
+                    if (journal.replay(expenses) > 0) autosave.markDirty();
                 }
+                break;
+            case 9:
+                storeLock.unlock();
+                autosave.stop();
                 std::cout << "Exiting program. Goodbye!\n";
                 break;
             default: std::cout << "Invalid option. Please try again.\n";
@@ -1,12 +1,28 @@
 #include "Expense.h"
+#include "ExpenseTable.h"
+#include "ExpenseQuery.h"
 #include "FileManager.h"
+#include "BinaryStore.h"
+#include "BlockStore.h"
+#include "Journal.h"
+#include "Autosave.h"
+#include "BufferedWriter.h"
 #include "Utils.h"
 #include <vector>
+#include <algorithm>
 #include <cstdio>
 #include <iostream>
 #include <string>
 #include <map>
 #include <cassert>
+#include <fstream>
+#include <iterator>
+#include <chrono>
+#include <thread>
+#include <filesystem>
+#include <sstream>
+#include <iomanip>
+#include <memory_resource>
 
 /**
  * @brief Test adding and viewing a single expense record.
@@ -15,14 +31,14 @@
  */
 void test_add_and_view_expense() {
     std::vector<Expense> expenses;
-    int origNextID = nextID;
-    Expense e{nextID++, "2025-10-24", 10.0, "Housing", "Test rent"};
+    IdAllocator ids;
+    Expense e{ids.allocate(), "2025-10-24", 10.0, "Housing", "Test rent"};
     expenses.push_back(e);
     assert(expenses.size() == 1);
+    assert(expenses[0].id == 1);
     assert(expenses[0].amount == 10.0);
     assert(expenses[0].category == "Housing");
     assert(expenses[0].description == "Test rent");
-    nextID = origNextID;
 }
 
 /**
@@ -200,7 +216,7 @@ void test_summary_calculations() {
         {2, "2025-10-25", 20.0, "Food & Dining", "Lunch"},
         {3, "2025-10-26", 30.0, "Housing", "Utilities"}
     };
-    double total = getTotalExpenses(expenses);
+    Money total = getTotalExpenses(expenses);
     assert(total == 60.0);
     auto perCat = getCategoryTotals(expenses);
     assert(perCat["Housing"] == 40.0);
@@ -248,7 +264,7 @@ void test_malformed_file_handling() {
 }
 
 /**
- * @brief Test duplicate ID and nextID increment logic.
+ * @brief Test duplicate ID and ID allocation logic.
  *
  * Ensures that new expenses get unique, incrementing IDs.
  */
@@ -257,12 +273,11 @@ void test_duplicate_id_and_nextid_logic() {
         {1, "2025-10-24", 10.0, "Housing", "Test rent"},
         {2, "2025-10-25", 20.0, "Food & Dining", "Lunch"}
     };
-    int origNextID = nextID;
-    nextID = 3;
-    Expense e{nextID++, "2025-10-26", 30.0, "Housing", "Utilities"};
-    expenses.push_back(e);
-    assert(expenses[2].id == 3);
-    nextID = origNextID;
+    ExpenseTable table(expenses);
+    Expense e{table.idAllocator().allocate(), "2025-10-26", 30.0, "Housing", "Utilities"};
+    table.push_back(e);
+    assert(table.ids()[2] == 3);
+    assert(table.idAllocator().allocate() == 4);
 }
 
 /**
@@ -318,11 +333,1042 @@ void test_persistence_after_reload() {
     std::remove("test_persist.csv");
 }
 
+/**
+ * @brief Test the in-place CSV row parser on irregular input.
+ *
+ * Ensures CRLF line endings, blank lines, and commas in descriptions are handled
+ * and that malformed rows are skipped instead of aborting the load.
+ */
+void test_csv_irregular_rows() {
+    std::FILE *f = std::fopen("test_irregular.csv", "w");
+    std::fputs("ID,Date,Amount,Category,Description\r\n"
+               "1,2025-10-24,10.5,Housing,Rent, October\r\n"
+               "\n"
+               "x,2025-10-25,20,Other,Bad id\n"
+               "2,2025-10-25,abc,Other,Bad amount\n"
+               "3,2025-10-26,30,Other\n"
+               "4,2025-10-27,1.23457e+06,Other,Old export", f);
+    std::fclose(f);
+    std::vector<Expense> loaded;
+    loadExpensesCSV(loaded, "test_irregular.csv");
+    assert(loaded.size() == 2);
+    assert(loaded[0].description == "Rent, October");
+    assert(loaded[0].amount == 10.5);
+    assert(loaded[1].id == 4);
+    assert(loaded[1].amount == 1234570.0);
+    std::remove("test_irregular.csv");
+}
+
+/**
+ * @brief Test parallel CSV parsing against the single-threaded parser.
+ *
+ * Ensures chunked parsing keeps file order, skips the same malformed rows and
+ * moves a table's ID allocator past the largest ID across all chunks.
+ */
+void test_csv_parallel_load() {
+    std::vector<Expense> expenses;
+    for (int i = 1; i <= 5000; ++i)
+        expenses.push_back({i * 3, "2025-10-24", i * 0.25, "Other", "Row " + std::to_string(i)});
+    saveExpensesCSV(expenses, "test_parallel.csv");
+    std::FILE *f = std::fopen("test_parallel.csv", "a");
+    std::fputs("oops,2025-10-24,1,Other,bad\n15003,2025-10-24,1,Other,Last", f);
+    std::fclose(f);
+
+    std::vector<Expense> sequential, parallel;
+    loadExpensesCSV(sequential, "test_parallel.csv", 1);
+    loadExpensesCSV(parallel, "test_parallel.csv", 4);
+    assert(sequential.size() == 5001);
+    assert(parallel.size() == sequential.size());
+    for (std::size_t i = 0; i < parallel.size(); ++i) {
+        assert(parallel[i].id == sequential[i].id);
+        assert(parallel[i].description == sequential[i].description);
+    }
+    ExpenseTable table;
+    table.assign(std::move(parallel));
+    assert(table.idAllocator().peek() == 15004);
+    std::remove("test_parallel.csv");
+}
+
+/**
+ * @brief Test the streaming JSON loader on extra and missing fields.
+ *
+ * Ensures unknown (even nested) fields are ignored, numbers of either kind are accepted,
+ * IDs are kept, and a record with a missing field rejects the whole file.
+ */
+void test_json_streaming_load() {
+    std::FILE *f = std::fopen("test_stream.json", "w");
+    std::fputs("[{\"id\": 41, \"date\": \"2025-10-24\", \"amount\": 12, \"note\": {\"a\": [1, 2]},"
+               " \"category\": \"Other\", \"description\": \"Caf\\u00e9 \\\"latte\\\"\"},"
+               " {\"description\": \"Bus\", \"category\": \"Transportation\", \"amount\": 2.75,"
+               " \"date\": \"2025-10-25\", \"id\": 42, \"flag\": true}]", f);
+    std::fclose(f);
+    std::vector<Expense> loaded;
+    loadExpensesJSON(loaded, "test_stream.json");
+    assert(loaded.size() == 2);
+    assert(loaded[0].amount == 12.0);
+    assert(loaded[0].description == "Caf\xc3\xa9 \"latte\"");
+    assert(loaded[1].id == 42);
+    assert(loaded[1].amount == 2.75);
+    assert(ExpenseTable(loaded).idAllocator().peek() == 43);
+
+    f = std::fopen("test_stream.json", "w");
+    std::fputs("[{\"id\": 1, \"date\": \"2025-10-24\", \"amount\": 12, \"category\": \"Other\"}]", f);
+    std::fclose(f);
+    loadExpensesJSON(loaded, "test_stream.json");
+    assert(loaded.empty());
+    std::remove("test_stream.json");
+}
+
+/**
+ * @brief Test the streaming JSON writer in both layouts.
+ *
+ * Ensures strings needing escapes survive a save/load round trip and that the compact
+ * layout has no indentation.
+ */
+void test_json_writer_styles() {
+    std::vector<Expense> expenses = {
+        {1, "2025-10-24", 1200.0, "Housing", "Tab\there \"quoted\" back\\slash \x01 caf\xc3\xa9"},
+        {2, "2025-10-25", 0.1, "Food & Dining", "Lunch"}
+    };
+    saveExpensesJSON(expenses, "test_styles.json", JsonStyle::Compact);
+    std::ifstream in("test_styles.json");
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    assert(text.find('\n') == std::string::npos);
+    assert(text.find("\"amount\":1200.0,") != std::string::npos);
+    std::vector<Expense> loaded;
+    loadExpensesJSON(loaded, "test_styles.json");
+    assert(loaded.size() == 2);
+    assert(loaded[0].description == expenses[0].description);
+    assert(loaded[1].amount == 0.1);
+
+    saveExpensesJSON(expenses, "test_styles.json", JsonStyle::Pretty);
+    loadExpensesJSON(loaded, "test_styles.json");
+    assert(loaded.size() == 2);
+    assert(loaded[0].description == expenses[0].description);
+    std::remove("test_styles.json");
+}
+
+/**
+ * @brief Test saving and loading the binary columnar snapshot.
+ *
+ * Verifies a round trip of all fields and that a corrupted file is rejected by its checksums.
+ */
+void test_save_and_load_expenses_binary() {
+    std::vector<Expense> expenses = {
+        {1, "2025-10-24", 10.25, "Housing", "Test rent"},
+        {2, "1999-12-31", 20.0, "Food & Dining", ""},
+        {7, "2024-02-29", 30.5, "Housing", "Utilities, water"}
+    };
+    saveExpensesBinary(expenses, "test_snapshot.expb");
+    std::vector<Expense> loaded;
+    loadExpensesBinary(loaded, "test_snapshot.expb");
+    assert(loaded.size() == 3);
+    for (std::size_t i = 0; i < loaded.size(); ++i) {
+        assert(loaded[i].id == expenses[i].id);
+        assert(loaded[i].date == expenses[i].date);
+        assert(loaded[i].amount == expenses[i].amount);
+        assert(loaded[i].category == expenses[i].category);
+        assert(loaded[i].description == expenses[i].description);
+    }
+
+    std::FILE *f = std::fopen("test_snapshot.expb", "r+b");
+    std::fseek(f, -3, SEEK_END);
+    std::fputc('X', f);
+    std::fclose(f);
+    loadExpensesBinary(loaded, "test_snapshot.expb");
+    assert(loaded.empty());
+
+    saveExpensesBinary({}, "test_snapshot.expb");
+    loadExpensesBinary(loaded, "test_snapshot.expb");
+    assert(loaded.empty());
+    std::remove("test_snapshot.expb");
+}
+
+/**
+ * @brief Test conversion between date strings and day numbers.
+ *
+ * Ensures the conversion round-trips across leap days and before the epoch.
+ */
+void test_date_day_numbers() {
+    int days = -1;
+    assert(dateToDays("1970-01-01", days) && days == 0);
+    assert(dateToDays("2000-03-01", days) && days == 11017);
+    assert(daysToDate(days) == "2000-03-01");
+    assert(dateToDays("1969-12-31", days) && days == -1);
+    assert(daysToDate(-1) == "1969-12-31");
+    assert(daysToDate(19782) == "2024-02-29");
+    assert(!dateToDays("2025-02-29", days));
+}
+
+/**
+ * @brief Test the packed Date type.
+ *
+ * Ensures dates parse once into day numbers, compare as integers, format back to
+ * YYYY-MM-DD (including through streams), and that rows with invalid dates are rejected.
+ */
+void test_date_type() {
+    Date d("2025-10-24");
+    assert(d.isValid());
+    assert(d == Date::fromDays(d.days()));
+    assert(d.toString() == "2025-10-24");
+    assert(d < Date("2025-10-25") && Date("2024-12-31") < d);
+    assert(d == std::string("2025-10-24"));
+    assert(!Date("2025-13-01").isValid() && !Date("2025-1-011").isValid() && !Date().isValid());
+    assert(Date().toString().empty());
+    std::ostringstream os;
+    os << std::left << std::setw(12) << d << "|";
+    assert(os.str() == "2025-10-24  |");
+    Expense e;
+    assert(parseExpenseCSVRow("1,2025-10-24,5,Other,Ok", e) && e.date == d);
+    assert(!parseExpenseCSVRow("1,2025-02-30,5,Other,Bad date", e));
+}
+
+/**
+ * @brief Test the integer-cents Money type.
+ *
+ * Ensures text is parsed straight to cents (with rounding and exponent fallback),
+ * that formatting is exact, and that totals over many rows match to the cent where
+ * summing doubles drifts.
+ */
+void test_money_cents() {
+    Money m;
+    assert(Money::parse("12.34", m) && m.cents() == 1234);
+    assert(Money::parse("0.1", m) && m.cents() == 10);
+    assert(Money::parse("-3.005", m) && m.cents() == -301);
+    assert(Money::parse("+7", m) && m.cents() == 700);
+    assert(Money::parse("1.23457e+06", m) && m.cents() == 123457000);
+    assert(!Money::parse("", m) && !Money::parse("12.3.4", m) && !Money::parse("abc", m) && !Money::parse("inf", m));
+    assert(Money(0.1) + Money(0.2) == Money(0.3));
+    assert(Money::fromCents(1230).toString() == "12.3");
+    assert(Money::fromCents(-5).toString() == "-0.05");
+    assert(Money::fromCents(1200).toString() == "12");
+    std::ostringstream os;
+    os << std::setw(8) << Money::fromCents(1230) << "|" << Money::fromCents(-5);
+    assert(os.str() == "   12.30|-0.05");
+
+    std::vector<Expense> expenses;
+    double drifting = 0;
+    for (int i = 0; i < 1000000; ++i) {
+        expenses.push_back({i + 1, "2025-10-24", 0.1, i % 2 ? "Housing" : "Other", ""});
+        drifting += 0.1;
+    }
+    assert(drifting != 100000.0);
+    assert(getTotalExpenses(expenses).cents() == 10000000);
+    assert(getCategoryTotals(expenses)["Housing"].cents() == 5000000);
+}
+
+/**
+ * @brief Test journal append and replay over a snapshot.
+ *
+ * Verifies that journaled adds/deletes are applied on replay, that replay is idempotent,
+ * and that a torn final record is ignored.
+ */
+void test_journal_replay() {
+    std::vector<Expense> snapshot = {
+        {1, "2025-10-24", 10.0, "Housing", "Test rent"},
+        {2, "2025-10-25", 20.0, "Food & Dining", "Lunch"}
+    };
+    saveExpensesCSV(snapshot, "test_journal.csv");
+    {
+        Journal journal;
+        journal.attach("test_journal.csv", "csv");
+        journal.recordAdd({3, "2025-10-26", 30.5, "Other", "Gift, wrapped"});
+        journal.recordDelete(1);
+        assert(journal.size() > 0);
+    }
+    std::FILE *f = std::fopen("test_journal.csv.journal", "a");
+    std::fputs("A,4,2025-10-27,1", f); // torn record
+    std::fclose(f);
+
+    std::vector<Expense> loaded;
+    loadExpensesCSV(loaded, "test_journal.csv");
+    Journal journal;
+    journal.attach("test_journal.csv", "csv");
+    assert(journal.replay(loaded) == 2);
+    assert(loaded.size() == 2);
+    assert(loaded[0].id == 2);
+    assert(loaded[1].id == 3);
+    assert(loaded[1].amount == 30.5);
+    assert(loaded[1].description == "Gift, wrapped");
+    assert(journal.replay(loaded) == 0); // idempotent
+    journal.detach();
+    std::remove("test_journal.csv.journal");
+    std::remove("test_journal.csv");
+}
+
+/**
+ * @brief Test journal checkpointing into the snapshot.
+ *
+ * Ensures a checkpoint rewrites the snapshot and empties the journal once it passes the threshold.
+ */
+void test_journal_checkpoint() {
+    std::vector<Expense> expenses = {{1, "2025-10-24", 10.0, "Housing", "Test rent"}};
+    saveExpensesJSON(expenses, "test_journal.json");
+    Journal journal(48);
+    journal.attach("test_journal.json", "json");
+    Expense e{2, "2025-10-25", 20.0, "Food & Dining", "Lunch"};
+    expenses.push_back(e);
+    journal.recordAdd(e);
+    assert(!journal.needsCheckpoint());
+    journal.recordDelete(1);
+    journal.recordDelete(7);
+    journal.recordDelete(8);
+    assert(journal.needsCheckpoint());
+    expenses.erase(expenses.begin());
+    journal.checkpointIfNeeded(expenses);
+    assert(journal.size() == 0);
+    std::vector<Expense> loaded;
+    loadExpensesJSON(loaded, "test_journal.json");
+    journal.replay(loaded);
+    assert(loaded.size() == 1);
+    assert(loaded[0].id == 2);
+    journal.detach();
+    std::remove("test_journal.json");
+}
+
+/**
+ * @brief Test the background autosave service.
+ *
+ * Ensures a burst of mutations is flushed once after the debounce interval, and that
+ * stop() flushes pending changes synchronously.
+ */
+void test_background_autosave() {
+    std::vector<Expense> expenses = {{1, "2025-10-24", 10.0, "Housing", "Test rent"}};
+    saveExpensesCSV(expenses, "test_autosave.csv");
+    Journal journal;
+    journal.attach("test_autosave.csv", "csv");
+    AutosaveService autosave(expenses, journal, std::chrono::milliseconds(50), 1000);
+    autosave.start();
+    for (int id = 2; id <= 4; ++id) {
+        auto lock = autosave.lock();
+        expenses.push_back({id, "2025-10-25", 5.0, "Other", "Burst"});
+        journal.recordAdd(expenses.back());
+        autosave.markDirty();
+    }
+    for (int i = 0; i < 200; ++i) {
+        {
+            auto lock = autosave.lock();
+            if (!autosave.isDirty()) break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::vector<Expense> loaded;
+    {
+        auto lock = autosave.lock();
+        assert(!autosave.isDirty());
+        assert(journal.size() == 0);
+        loadExpensesCSV(loaded, "test_autosave.csv");
+        assert(loaded.size() == 4);
+
+        expenses.erase(expenses.begin());
+        journal.recordDelete(1);
+        autosave.markDirty();
+    }
+    autosave.stop();
+    assert(journal.size() == 0);
+    loadExpensesCSV(loaded, "test_autosave.csv");
+    assert(loaded.size() == 3);
+    assert(loaded[0].id == 2);
+    journal.detach();
+    std::remove("test_autosave.csv");
+}
+
+/**
+ * @brief Test that saves replace the target atomically.
+ *
+ * Ensures an abandoned write leaves the previous file untouched and no temporary file
+ * behind, and that a completed save leaves no temporary file either.
+ */
+void test_atomic_save() {
+    std::vector<Expense> expenses = {{1, "2025-10-24", 10.0, "Housing", "Test rent"}};
+    saveExpensesCSV(expenses, "test_atomic.csv");
+    assert(!std::filesystem::exists(BufferedWriter::tempPathFor("test_atomic.csv")));
+    {
+        BufferedWriter out;
+        assert(out.open("test_atomic.csv"));
+        out.write("ID,Date,Amount,Category,Description\n2,2025-10");
+        out.flush();
+        // Destroyed without close(), as if the process died mid-save
+    }
+    assert(!std::filesystem::exists(BufferedWriter::tempPathFor("test_atomic.csv")));
+    std::vector<Expense> loaded;
+    loadExpensesCSV(loaded, "test_atomic.csv");
+    assert(loaded.size() == 1);
+    assert(loaded[0].description == "Test rent");
+    std::remove("test_atomic.csv");
+}
+
+/**
+ * @brief Test the journal sync modes.
+ *
+ * Ensures Always issues one fsync per record, while Group covers a burst of records
+ * with fewer fsyncs and still syncs everything before the journal is closed.
+ */
+void test_journal_group_commit() {
+    std::vector<Expense> expenses;
+    saveExpensesCSV(expenses, "test_group.csv");
+    {
+        Journal journal(DEFAULT_JOURNAL_CHECKPOINT_BYTES, JournalSync::Always);
+        journal.attach("test_group.csv", "csv");
+        for (int id = 1; id <= 3; ++id) journal.recordAdd({id, "2025-10-25", 5.0, "Other", "Always"});
+        assert(journal.syncCount() == 3);
+        journal.reset();
+    }
+    {
+        Journal journal(DEFAULT_JOURNAL_CHECKPOINT_BYTES, JournalSync::Group, std::chrono::milliseconds(50));
+        journal.attach("test_group.csv", "csv");
+        for (int id = 1; id <= 20; ++id) journal.recordAdd({id, "2025-10-25", 5.0, "Other", "Group"});
+        journal.sync();
+        assert(journal.syncCount() >= 1 && journal.syncCount() < 20);
+        std::size_t synced = journal.syncCount();
+        journal.sync();
+        assert(journal.syncCount() == synced);
+        std::vector<Expense> loaded;
+        assert(journal.replay(loaded) == 20);
+        journal.reset();
+    }
+    std::remove("test_group.csv");
+}
+
+/**
+ * @brief Test appending expenses to existing CSV and JSON files in place.
+ *
+ * Ensures the appended files are byte-identical to a full save in both JSON layouts,
+ * that files which cannot be appended to are left alone, and that a journal holding
+ * only adds is checkpointed by appending.
+ */
+void test_incremental_append() {
+    std::vector<Expense> expenses = {{1, "2025-10-24", 10.0, "Housing", "Test rent"}};
+    std::vector<Expense> added = {{2, "2025-10-25", 20.5, "Food & Dining", "Lunch \"deli\""},
+                                  {3, "2025-10-26", 7.0, "Other", "Misc"}};
+    std::vector<Expense> all = expenses;
+    all.insert(all.end(), added.begin(), added.end());
+    auto readFile = [](const char *name) {
+        std::ifstream in(name, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+    for (JsonStyle style : {JsonStyle::Pretty, JsonStyle::Compact}) {
+        saveExpensesJSON(all, "test_append_full.json", style);
+        saveExpensesJSON(expenses, "test_append.json", style);
+        assert(appendExpensesJSON(added, "test_append.json"));
+        assert(readFile("test_append.json") == readFile("test_append_full.json"));
+        saveExpensesJSON({}, "test_append.json", style);
+        assert(appendExpensesJSON(all, "test_append.json"));
+        std::vector<Expense> loaded;
+        loadExpensesJSON(loaded, "test_append.json");
+        assert(loaded.size() == 3);
+        assert(loaded[1].description == "Lunch \"deli\"");
+    }
+    saveExpensesCSV(all, "test_append_full.csv");
+    saveExpensesCSV(expenses, "test_append.csv");
+    assert(appendExpensesCSV(added, "test_append.csv"));
+    assert(readFile("test_append.csv") == readFile("test_append_full.csv"));
+
+    std::ofstream("test_append.json") << "{\"not\": \"an array\"}";
+    assert(!appendExpensesJSON(added, "test_append.json"));
+    assert(readFile("test_append.json") == "{\"not\": \"an array\"}");
+    assert(!appendExpenses(added, "test_append_missing.csv", "csv"));
+
+    // A journal of pure adds is folded in by appending; the old bytes stay in place
+    saveExpensesJSON(expenses, "test_append.json", JsonStyle::Compact);
+    std::string before = readFile("test_append.json");
+    {
+        Journal journal;
+        journal.attach("test_append.json", "json");
+        for (const auto &e : added) journal.recordAdd(e);
+        journal.checkpoint(all);
+        assert(journal.size() == 0);
+    }
+    std::string after = readFile("test_append.json");
+    assert(after.compare(0, before.size() - 1, before, 0, before.size() - 1) == 0);
+    std::vector<Expense> loaded;
+    loadExpensesJSON(loaded, "test_append.json");
+    assert(loaded.size() == 3);
+    assert(loaded[2].id == 3);
+    std::remove("test_append.json");
+    std::remove("test_append_full.json");
+    std::remove("test_append.csv");
+    std::remove("test_append_full.csv");
+}
+
+/**
+ * @brief Test the block-compressed archive format (.expz).
+ *
+ * Ensures a multi-block round trip preserves every field, that scans skip blocks
+ * whose zone maps rule out the filter, and that corruption is detected.
+ */
+void test_block_compressed_store() {
+    std::vector<Expense> expenses;
+    const char *cats[] = {"Housing", "Food & Dining", "Other"};
+    for (int i = 0; i < 1000; ++i) {
+        // Ten blocks of 100 rows, each block covering its own ten days
+        std::string date = daysToDate(20000 + i / 10);
+        expenses.push_back({i + 1, date, 1.0 + i, i < 500 ? cats[i % 2] : cats[2], "Row " + std::to_string(i)});
+    }
+    saveExpensesBlocks(expenses, "test_blocks.expz", 100);
+    std::vector<Expense> loaded;
+    loadExpensesBlocks(loaded, "test_blocks.expz");
+    assert(loaded.size() == expenses.size());
+    for (std::size_t i = 0; i < loaded.size(); ++i) {
+        assert(loaded[i].id == expenses[i].id);
+        assert(loaded[i].date == expenses[i].date);
+        assert(loaded[i].amount == expenses[i].amount);
+        assert(loaded[i].category == expenses[i].category);
+        assert(loaded[i].description == expenses[i].description);
+    }
+    assert(ExpenseTable(loaded).idAllocator().peek() == 1001);
+
+    std::vector<Expense> matches;
+    BlockFilter byDate;
+    byDate.startDate = daysToDate(20015);
+    byDate.endDate = daysToDate(20024);
+    BlockScanStats stats = scanExpensesBlocks("test_blocks.expz", byDate, matches);
+    assert(stats.blocks == 10);
+    assert(stats.skippedBlocks == 8);
+    assert(matches.size() == 100);
+    assert(matches.front().date == byDate.startDate && matches.back().date == byDate.endDate);
+
+    BlockFilter byCategory;
+    byCategory.category = "Other";
+    byCategory.minAmount = 900.0;
+    stats = scanExpensesBlocks("test_blocks.expz", byCategory, matches);
+    assert(stats.skippedBlocks == 8);
+    assert(matches.size() == 101);
+    byCategory.category = "Transportation";
+    stats = scanExpensesBlocks("test_blocks.expz", byCategory, matches);
+    assert(stats.skippedBlocks == 10 && matches.empty());
+
+    saveExpensesBlocks({}, "test_blocks.expz");
+    loadExpensesBlocks(loaded, "test_blocks.expz");
+    assert(loaded.empty());
+
+    saveExpensesBlocks(expenses, "test_blocks.expz", 100);
+    {
+        std::fstream f("test_blocks.expz", std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(-10, std::ios::end);
+        f.put('\x7f');
+    }
+    loadExpensesBlocks(loaded, "test_blocks.expz");
+    assert(loaded.empty());
+    std::remove("test_blocks.expz");
+}
+
 /**
  * @brief Main entry point for running all Expense Tracker tests.
  *
  * Runs all test functions and prints a summary message if all pass.
  */
+/**
+ * @brief Test interned category IDs.
+ *
+ * Built-in categories keep their menu numbers, new names get stable IDs
+ * (also when interned from several threads), and comparing with a name does
+ * not register it.
+ */
+void test_category_interning() {
+    for (int i = 1; i <= 7; ++i)
+        assert(Category::fromId(static_cast<std::uint16_t>(i)).name() == getCategoryByNumber(i));
+    assert(Category("Housing").id() == 1 && Category().name().empty());
+
+    std::size_t before = Category::count();
+    Category probe;
+    assert(!Category::find("Never Interned Category", probe));
+    assert(Category("Housing") != "Never Interned Category");
+    assert(Category::count() == before);
+
+    std::vector<std::thread> threads;
+    std::vector<std::uint16_t> ids(8);
+    for (std::size_t t = 0; t < ids.size(); ++t)
+        threads.emplace_back([&ids, t] { ids[t] = Category::intern("Pets & Animals").id(); });
+    for (auto &th : threads) th.join();
+    for (std::uint16_t id : ids) assert(id == ids[0]);
+    assert(ids[0] >= Category::BUILTIN_COUNT && Category::count() == before + 1);
+    assert(Category::fromId(ids[0]) == "Pets & Animals");
+
+    std::vector<Expense> expenses = {{1, "2025-10-24", 5.0, "Pets & Animals", "food"},
+                                     {2, "2025-10-24", 7.0, "Housing", "rent"}};
+    assert(filterByCategory(expenses, "Pets & Animals").size() == 1);
+    assert(filterByCategory(expenses, "Never Interned Category").empty());
+    assert(getCategoryTotals(expenses)["Pets & Animals"].cents() == 500);
+    assert(sizeof(Expense().category) == sizeof(std::uint16_t));
+}
+/**
+ * @brief Test arena-backed descriptions.
+ *
+ * Checks the arena itself, that copies share the text instead of duplicating
+ * it, and that descriptions loaded from a binary snapshot point into the
+ * mapping and stay readable after the file is removed.
+ */
+void test_description_arena() {
+    auto arena = std::make_shared<StringArena>(64);
+    std::string_view a = arena->store("Rent");
+    std::string_view big = arena->store(std::string(100, 'x'));
+    assert(a == "Rent" && big.size() == 100 && arena->bytesUsed() == 104);
+    Description d = Description::inArena(arena, "Lunch");
+    Description copy = d;
+    assert(copy == "Lunch" && d.view() == "Lunch");
+    if (!d.isInline()) assert(copy.data() == d.data());
+    assert(Description().empty() && Description(std::string("x")) == std::string("x"));
+
+    std::vector<Expense> expenses;
+    for (int i = 1; i <= 100; ++i)
+        expenses.push_back({i, "2025-10-24", 1.0, "Other", "Item " + std::to_string(i)});
+    saveExpensesBinary(expenses, "test_arena.expb");
+    std::vector<Expense> loaded;
+    loadExpensesBinary(loaded, "test_arena.expb");
+    std::remove("test_arena.expb");
+    assert(loaded.size() == 100);
+    // All descriptions live in one mapped heap, back to back
+    if (!loaded[0].description.isInline())
+        assert(loaded[1].description.data() == loaded[0].description.data() + loaded[0].description.size());
+    assert(loaded[99].description == "Item 100");
+
+    saveExpensesCSV(expenses, "test_arena.csv");
+    loadExpensesCSV(loaded, "test_arena.csv");
+    std::remove("test_arena.csv");
+    if (!loaded[0].description.isInline())
+        assert(loaded[1].description.data() == loaded[0].description.data() + loaded[0].description.size());
+    assert(loaded[42].description == expenses[42].description);
+}
+/**
+ * @brief Test the column-oriented expense table.
+ *
+ * Ensures rows round-trip through the columns in order, the iterator yields
+ * whole expenses, and the column-scanning filters and totals agree with the
+ * vector versions.
+ */
+void test_expense_table() {
+    std::vector<Expense> expenses = {{1, "2025-10-24", 10.0, "Housing", "Rent"},
+                                     {2, "2025-10-25", 2.5, "Food & Dining", "Coffee"},
+                                     {3, "2025-10-24", 4.25, "Housing", "Repairs"}};
+    ExpenseTable table(expenses);
+    assert(table.size() == 3 && table.ids()[1] == 2 && table.amounts()[2].cents() == 425);
+    int seen = 0;
+    for (const auto &e : table) {
+        assert(e.id == expenses[seen].id && e.description == expenses[seen].description);
+        ++seen;
+    }
+    assert(seen == 3 && std::distance(table.begin(), table.end()) == 3);
+    assert(getTotalExpenses(table) == getTotalExpenses(expenses));
+    assert(getCategoryTotals(table) == getCategoryTotals(expenses));
+    assert(filterByCategory(table, "Housing").size() == 2);
+    assert(filterByDate(table, "2025-10-24")[1].id == 3);
+
+    table.erase(0);
+    assert(table.size() == 2 && (*table.begin()).id == 2 && table.back().description == "Repairs");
+    assert(table.find(3) == 2 && table.find(1) == ExpenseTable::npos);
+    std::vector<Expense> copy = table.toVector();
+    table.assign(std::move(copy));
+    assert(copy.empty() && table.back().id == 3 && table.find(2) == 0);
+
+    saveExpensesCSV(expenses, "test_table.csv");
+    Journal journal;
+    journal.attach("test_table.csv", "csv");
+    journal.recordAdd({4, "2025-10-26", 1.0, "Other", "Bus"});
+    journal.recordDelete(2);
+    journal.sync();
+    ExpenseTable loaded;
+    loadExpenses(loaded, "test_table.csv", "csv");
+    assert(journal.replay(loaded) == 2);
+    assert(loaded.size() == 3 && loaded.find(2) == ExpenseTable::npos && loaded.back().description == "Bus");
+    journal.checkpoint(loaded);
+    std::vector<Expense> reloaded;
+    loadExpensesCSV(reloaded, "test_table.csv");
+    assert(reloaded.size() == 3 && reloaded[1].id == 3 && reloaded[2].id == 4);
+    journal.detach();
+    std::remove("test_table.csv");
+}
+/**
+ * @brief Test the expense table's ID index.
+ *
+ * Ensures find() stays correct through a mass delete,
+ * and that a duplicated ID remains deletable after its first copy is gone.
+ */
+void test_expense_id_index() {
+    ExpenseTable table;
+    const int rows = 50000;
+    for (int id = 1; id <= rows; ++id) table.push_back({id, "2025-10-24", 1.0, "Other", ""});
+    for (int id = 2; id <= rows; id += 2) assert(table.remove(id));
+    assert(table.size() == rows / 2 && !table.remove(2));
+    for (int id = 1; id <= rows; ++id) {
+        std::size_t slot = table.find(id);
+        assert((slot != ExpenseTable::npos) == (id % 2 == 1));
+        if (slot != ExpenseTable::npos) assert(table.ids()[slot] == id);
+    }
+
+    table.assign({{7, "2025-10-24", 1.0, "Other", "a"}, {7, "2025-10-24", 2.0, "Other", "b"},
+                  {8, "2025-10-24", 3.0, "Other", "c"}});
+    assert(table.remove(7) && table.contains(7) && table.remove(7) && !table.contains(7));
+    assert(table.size() == 1 && table.find(8) == 2);
+}
+/**
+ * @brief Test tombstone deletes and compaction.
+ *
+ * Ensures deletes leave slots and iterators in place, scans and saves skip the
+ * tombstones, and compaction keeps row order and the ID index intact, both
+ * when called directly and from the background autosave.
+ */
+void test_tombstone_compaction() {
+    ExpenseTable table;
+    for (int id = 1; id <= 8; ++id) table.push_back({id, "2025-10-24", id * 1.0, "Other", "Row"});
+    auto it = table.begin();
+    ++it;
+    for (int id = 3; id <= 8; id += 2) table.remove(id);
+    assert((*it).id == 2 && it.slot() == 1); // a held iterator still sees its row
+    ++it;
+    assert((*it).id == 4);
+    assert(table.size() == 5 && table.tombstones() == 3 && table.needsCompaction());
+    assert(getTotalExpenses(table).cents() == (1 + 2 + 4 + 6 + 8) * 100);
+    assert(filterByCategory(table, "Other").size() == 5);
+
+    saveExpenses(table, "test_tombstones.csv", "csv");
+    std::vector<Expense> saved;
+    loadExpensesCSV(saved, "test_tombstones.csv");
+    assert(saved.size() == 5 && saved[2].id == 4);
+
+    table.compact();
+    assert(table.slots() == 5 && table.tombstones() == 0 && !table.needsCompaction());
+    std::vector<int> order;
+    for (const auto &e : table) order.push_back(e.id);
+    assert((order == std::vector<int>{1, 2, 4, 6, 8}));
+    assert(table.find(6) == 3 && table.ids()[table.find(8)] == 8);
+
+    Journal journal;
+    journal.attach("test_tombstones.csv", "csv");
+    AutosaveService autosave(table, journal, std::chrono::milliseconds(10), 1000);
+    {
+        auto lock = autosave.lock();
+        for (int id : {1, 2, 4}) {
+            table.remove(id);
+            journal.recordDelete(id);
+            autosave.markDirty();
+        }
+        assert(table.tombstones() == 3);
+    }
+    autosave.stop();
+    assert(table.tombstones() == 0 && table.slots() == 2 && table.find(8) == 1);
+    loadExpensesCSV(saved, "test_tombstones.csv");
+    assert(saved.size() == 2 && saved[0].id == 6);
+    journal.detach();
+    std::remove("test_tombstones.csv");
+}
+/**
+ * @brief Test the per-store ID allocator.
+ *
+ * Ensures two tables allocate independently, observed IDs are never handed
+ * out again, and concurrent allocations and range reservations never overlap.
+ */
+void test_id_allocator() {
+    ExpenseTable a, b;
+    a.push_back({5000000000LL, "2025-10-24", 1.0, "Other", "Big ID"});
+    assert(a.idAllocator().allocate() == 5000000001LL);
+    assert(b.idAllocator().allocate() == 1);
+    b.idAllocator().observe(10);
+    b.idAllocator().observe(3); // never moves backwards
+    assert(b.idAllocator().peek() == 11);
+
+    IdAllocator ids;
+    const int threads = 4, perThread = 10000;
+    std::vector<std::vector<std::int64_t>> taken(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&ids, &taken, t] {
+            for (int i = 0; i < perThread; ++i) {
+                if (i % 100 == 0) {
+                    std::int64_t first = ids.reserve(50);
+                    for (std::int64_t id = first; id < first + 50; ++id) taken[t].push_back(id);
+                } else {
+                    taken[t].push_back(ids.allocate());
+                }
+            }
+        });
+    }
+    for (auto &w : workers) w.join();
+    std::vector<std::int64_t> all;
+    for (const auto &list : taken) all.insert(all.end(), list.begin(), list.end());
+    std::sort(all.begin(), all.end());
+    assert(std::adjacent_find(all.begin(), all.end()) == all.end());
+    assert(ids.peek() == 1 + static_cast<std::int64_t>(all.size()));
+}
+/**
+ * @brief Test the description layout selected at build time.
+ *
+ * Runs under both layouts: text within the inline capacity is stored inside
+ * the description and copied by value, longer text falls back to shared
+ * storage, and copies compare equal either way.
+ */
+void test_description_layout() {
+    Description shortText("Coffee");
+    Description longText(std::string(MAX_DESCRIPTION_LENGTH + 1, 'x'));
+    assert(shortText.isInline() == (Description::INLINE_CAPACITY >= 6));
+    assert(!longText.isInline() && longText.size() == MAX_DESCRIPTION_LENGTH + 1);
+    assert(!Description().isInline());
+
+    Description copy = shortText;
+    assert(copy == "Coffee" && copy.isInline() == shortText.isInline());
+    if (copy.isInline()) assert(copy.data() != shortText.data());
+    copy = longText;
+    assert(copy == longText && copy.data() == longText.data());
+
+    auto arena = std::make_shared<StringArena>();
+    Description stored = Description::inArena(arena, "Lunch");
+    assert(stored == "Lunch" && (arena->bytesUsed() == 0) == stored.isInline());
+
+    // Copies made while filtering keep their text after the source is gone
+    std::vector<Expense> filtered;
+    {
+        std::vector<Expense> expenses = {{1, "2025-10-24", 10.0, "Housing", "Rent"},
+                                         {2, "2025-10-25", 2.5, "Food & Dining", "Coffee"}};
+        filtered = filterByCategory(expenses, "Housing");
+    }
+    assert(filtered.size() == 1 && filtered[0].description == "Rent");
+}
+/**
+ * @brief Test the table's date index.
+ *
+ * Ensures the index is sorted after a load and after in-order and back-dated
+ * appends, that range queries find exactly the rows in range, and that it
+ * survives deletes and compaction.
+ */
+void test_date_index() {
+    std::vector<Expense> expenses = {{1, "2025-03-10", 1.0, "Other", "c"},
+                                     {2, "2025-01-05", 2.0, "Other", "a"},
+                                     {3, "2025-02-20", 3.0, "Other", "b"},
+                                     {4, "2025-01-05", 4.0, "Other", "a2"}};
+    ExpenseTable table(expenses);
+    auto datesInOrder = [&table]() {
+        std::vector<std::int64_t> ids;
+        for (std::size_t slot : table.byDate())
+            if (table.isLive(slot)) ids.push_back(table.ids()[slot]);
+        return ids;
+    };
+    assert((datesInOrder() == std::vector<std::int64_t>{2, 4, 3, 1}));
+
+    table.push_back({5, "2025-04-01", 5.0, "Other", "d"});
+    table.push_back({6, "2025-02-01", 6.0, "Other", "back-dated"});
+    assert((datesInOrder() == std::vector<std::int64_t>{2, 4, 6, 3, 1, 5}));
+
+    auto range = table.dateRange(Date("2025-01-06"), Date("2025-03-10"));
+    assert(range.second - range.first == 3);
+    assert(table.ids()[table.byDate()[range.first]] == 6);
+    range = table.dateRange(Date("2025-03-11"), Date("2025-01-01"));
+    assert(range.first == range.second);
+    assert(filterByDate(table, "2025-01-05").size() == 2);
+
+    table.remove(4);
+    table.remove(3);
+    assert(filterByDate(table, "2025-01-05").size() == 1);
+    table.compact();
+    assert(table.byDate().size() == table.size());
+    assert((datesInOrder() == std::vector<std::int64_t>{2, 6, 1, 5}));
+    range = table.dateRange(Date("2025-02-01"), Date("2025-12-31"));
+    assert(range.second - range.first == 3);
+}
+/**
+ * @brief Test the category posting lists and slot bitmaps.
+ *
+ * Ensures each category lists exactly its rows, that the lists follow
+ * appends, deletes and compaction, and that a category bitmap ANDed with a
+ * date bitmap gives the rows matching both.
+ */
+void test_category_index() {
+    std::vector<Expense> expenses = {{1, "2025-01-05", 1.0, "Housing", "Rent"},
+                                     {2, "2025-01-06", 2.0, "Food & Dining", "Lunch"},
+                                     {3, "2025-02-05", 3.0, "Housing", "Rent"},
+                                     {4, "2025-02-07", 4.0, "Food & Dining", "Dinner"}};
+    ExpenseTable table(expenses);
+    assert((table.slotsIn(Category("Housing")) == std::pmr::vector<std::size_t>{0, 2}));
+    assert(table.slotsIn(Category("Transportation")).empty());
+    table.push_back({5, "2025-02-10", 5.0, "Housing", "Repairs"});
+    assert(table.slotsIn(Category("Housing")).back() == 4);
+
+    SlotBitmap february = table.dateBitmap(Date("2025-02-01"), Date("2025-02-28"));
+    SlotBitmap housing = table.categoryBitmap(Category("Housing"));
+    assert(february.count() == 3 && housing.count() == 3);
+    housing &= february;
+    assert((housing.toSlots() == std::vector<std::size_t>{2, 4}));
+    SlotBitmap either = table.categoryBitmap(Category("Food & Dining"));
+    either |= table.categoryBitmap(Category("Housing"));
+    assert(either.count() == 5 && either.test(1) && !SlotBitmap(130).test(129));
+
+    table.remove(1);
+    assert(table.categoryBitmap(Category("Housing")).count() == 2);
+    assert(filterByCategory(table, "Housing").size() == 2);
+    table.compact();
+    assert((table.slotsIn(Category("Housing")) == std::pmr::vector<std::size_t>{1, 3}));
+    assert((table.slotsIn(Category("Food & Dining")) == std::pmr::vector<std::size_t>{0, 2}));
+    assert(filterByCategory(table, "Housing")[0].id == 3);
+}
+/**
+ * @brief Test multi-predicate queries and the planner's choice of index.
+ *
+ * Ensures each combination of predicates returns the same rows as a brute
+ * force check, in table order, and that the planner drives the query from
+ * the most selective index.
+ */
+void test_expense_query() {
+    std::vector<Expense> expenses;
+    const char *categories[] = {"Housing", "Food & Dining", "Transportation", "Other"};
+    for (int i = 0; i < 400; ++i) {
+        Date date = Date::fromDays(Date("2024-01-01").days() + i);
+        expenses.push_back({i + 1, date, Money::fromCents(100 * (i % 50)), categories[i % 4],
+                            i % 7 == 0 ? "Uber ride" : "Groceries"});
+    }
+    ExpenseTable table(expenses);
+    table.remove(5);
+
+    ExpenseQuery all;
+    assert(all.plan(table).source == QueryPlan::FullScan && all.run(table).size() == 399);
+
+    ExpenseQuery week;
+    week.between(Date("2024-03-01"), Date("2024-03-07")).inCategory("Housing").inCategory("Other");
+    assert(week.plan(table).source == QueryPlan::DateIndex && week.plan(table).candidates == 7);
+    ExpenseQuery food;
+    food.inCategory("Food & Dining").amountBetween(Money(10.0), Money(20.0)).descriptionContains("Uber");
+    assert(food.plan(table).source == QueryPlan::CategoryIndex && food.plan(table).candidates == 100);
+    assert(food.plan(table).describe() == "category index (100 candidates)");
+
+    ExpenseQuery wide;
+    wide.between(Date("2024-01-01"), Date("2024-12-31")).inCategory("Housing").inCategory("Transportation");
+    assert(wide.plan(table).source == QueryPlan::CategoryIndex);
+
+    for (const ExpenseQuery *query : {&week, &food, &wide}) {
+        std::pmr::vector<std::size_t> expected;
+        for (std::size_t slot = 0; slot < table.slots(); ++slot)
+            if (query->matches(table, slot)) expected.push_back(slot);
+        assert(query->run(table).slots() == expected && !expected.empty());
+    }
+    assert(week.run(table).size() == 3);
+    assert(ExpenseQuery().between(Date("2025-01-01"), Date("2024-01-01")).run(table).empty());
+}
+/**
+ * @brief Test filter results returned as views over the table.
+ *
+ * Ensures a view refers to the table's rows in place, and can be iterated,
+ * counted, summed, rendered and copied out.
+ */
+void test_expense_view() {
+    std::vector<Expense> expenses = {{1, "2025-10-24", 10.0, "Housing", "Rent"},
+                                     {2, "2025-10-25", 2.5, "Food & Dining", "Coffee"},
+                                     {3, "2025-10-26", 4.25, "Housing", "Repairs"}};
+    ExpenseTable table(expenses);
+    ExpenseView housing = filterByCategory(table, "Housing");
+    assert(housing.size() == 2 && housing[1].id == 3);
+    assert(&housing[0].description == &table.descriptions()[0]);
+    assert(housing.total().cents() == 1425);
+
+    std::vector<std::int64_t> ids;
+    for (const auto &e : housing) ids.push_back(e.id);
+    assert((ids == std::vector<std::int64_t>{1, 3}));
+    Expense copy = housing[1];
+    assert(copy.description == "Repairs" && housing.toVector().size() == 2);
+
+    std::ostringstream out;
+    housing.render(out);
+    assert(out.str().find("Repairs") != std::string::npos && out.str().find("Coffee") == std::string::npos);
+    std::ostringstream bare;
+    housing.render(bare, false);
+    assert(bare.str().find("Housing") == std::string::npos);
+
+    ExpenseView range = filterByDateRange(table, Date("2025-10-25"), Date("2025-12-31"));
+    assert(range.size() == 2 && range.total().cents() == 675 && range.begin().slot() == 1);
+    assert(filterByDateRange(table, Date("2026-01-01"), Date("2026-12-31")).empty());
+}
+/**
+ * @brief Test the word index over descriptions.
+ *
+ * Checks tokenizing, term, prefix and phrase searches, and that the index
+ * follows loads, adds, deletes and compaction.
+ */
+void test_text_index() {
+    assert((TextIndex::tokenize("Uber ride, to AIRPORT!") ==
+            std::vector<std::string>{"uber", "ride", "to", "airport"}));
+
+    std::vector<Expense> expenses = {{1, "2025-01-05", 12.0, "Transportation", "Uber ride to airport"},
+                                     {2, "2025-01-06", 30.0, "Food & Dining", "Uber Eats dinner"},
+                                     {3, "2025-01-07", 900.0, "Housing", "Rent January"},
+                                     {4, "2025-01-08", 8.0, "Food & Dining", "Dinner with uber-driver friend"}};
+    ExpenseTable table(expenses);
+    assert((searchByTerm(table, "UBER").slots() == std::pmr::vector<std::size_t>{0, 1, 3}));
+    assert(searchByTerm(table, "rent").size() == 1 && searchByTerm(table, "rental").empty());
+    assert(searchByTerm(table, "two words").empty());
+    assert(searchByPrefix(table, "din").size() == 2 && searchByPrefix(table, "x").empty());
+    assert((searchByPhrase(table, "uber eats").slots() == std::pmr::vector<std::size_t>{1}));
+    assert(searchByPhrase(table, "eats uber").empty());
+    assert(searchByPhrase(table, "uber driver")[0].id == 4);
+
+    table.push_back({5, "2025-01-09", 25.0, "Food & Dining", "UberEats lunch"});
+    assert(searchByPrefix(table, "uber").size() == 4 && searchByTerm(table, "ubereats").total().cents() == 2500);
+    table.remove(2);
+    assert(searchByPhrase(table, "uber eats").empty());
+    table.compact();
+    assert((searchByTerm(table, "uber").slots() == std::pmr::vector<std::size_t>{0, 2}));
+    assert(searchByTerm(table, "ubereats")[0].id == 5);
+    assert(table.textIndex().term("eats").empty());
+}
+/**
+ * @brief Memory resource that counts the allocations it forwards to new/delete.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+/**
+ * @brief Test loading and filtering a table on a caller-supplied memory resource.
+ *
+ * Ensures the columns, the loaded and added descriptions and the filter
+ * results come from the table's resource, and that a table on a monotonic
+ * buffer behaves like any other.
+ */
+void test_memory_resource() {
+    std::vector<Expense> expenses;
+    for (int i = 1; i <= 50; ++i)
+        expenses.push_back({i, "2025-10-24", 1.0, i % 2 ? "Housing" : "Other",
+                            "A description long enough to need storage " + std::to_string(i)});
+    saveExpensesCSV(expenses, "test_pmr.csv");
+    saveExpensesJSON(expenses, "test_pmr.json");
+
+    CountingResource counting;
+    {
+        ExpenseTable table(&counting);
+        assert(table.resource() == &counting);
+        loadExpenses(table, "test_pmr.csv", "csv");
+        std::size_t loadAllocations = counting.allocations;
+        assert(table.size() == 50 && loadAllocations > 0);
+        assert(table.descriptions()[49] == expenses[49].description);
+
+        auto housing = filterByCategory(table, "Housing");
+        assert(housing.size() == 25 && housing.resource() == &counting);
+        assert(counting.allocations > loadAllocations);
+        std::pmr::monotonic_buffer_resource scratch;
+        assert(filterByDate(table, "2025-10-24", &scratch).resource() == &scratch);
+
+        std::size_t before = counting.allocations;
+        Description added = table.storeDescription(std::string(MAX_DESCRIPTION_LENGTH + 1, 'y'));
+        assert(added.size() == MAX_DESCRIPTION_LENGTH + 1 && counting.allocations > before);
+    }
+
+    std::pmr::monotonic_buffer_resource buffer;
+    {
+        ExpenseTable table(&buffer);
+        loadExpenses(table, "test_pmr.json", "json");
+        assert(table.size() == 50 && getTotalExpenses(table).cents() == 5000);
+        assert(table.row(0).description == expenses[0].description);
+    }
+    std::remove("test_pmr.csv");
+    std::remove("test_pmr.json");
+}
 int main() {
     std::cout << "Running Expense Tracker tests...\n";
     test_add_and_view_expense();
@@ -344,6 +1390,34 @@ int main() {
     test_expense_equality_and_assignment();
     test_handle_empty_expense_list();
     test_persistence_after_reload();
+    test_csv_irregular_rows();
+    test_csv_parallel_load();
+    test_json_streaming_load();
+    test_json_writer_styles();
+    test_save_and_load_expenses_binary();
+    test_date_day_numbers();
+    test_date_type();
+    test_money_cents();
+    test_journal_replay();
+    test_journal_checkpoint();
+    test_background_autosave();
+    test_atomic_save();
+    test_journal_group_commit();
+    test_incremental_append();
+    test_block_compressed_store();
+    test_category_interning();
+    test_description_arena();
+    test_expense_table();
+    test_expense_id_index();
+    test_tombstone_compaction();
+    test_id_allocator();
+    test_description_layout();
+    test_memory_resource();
+    test_date_index();
+    test_category_index();
+    test_expense_query();
+    test_expense_view();
+    test_text_index();
     std::cout << "All tests passed!\n";
     return 0;
 }